@@ -12,6 +12,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-18: DirectX11: Upload the font texture rectangle modified by ImFontAtlas::UpdateDynamicGlyphs() (ImFontAtlasFlags_DynamicGlyphs).
 //  2021-06-29: Reorganized backend to pull data from a single structure to facilitate usage with multiple-contexts (all g_XXXX access changed to bd->XXXX).
 //  2021-05-19: DirectX11: Replaced direct access to ImDrawCmd::TextureId with a call to ImDrawCmd::GetTexID(). (will become a requirement)
 //  2021-02-18: DirectX11: Change blending equation to preserve alpha in output buffer.
@@ -114,8 +115,30 @@ static void ImGui_ImplDX11_SetupRenderState(ImDrawData* draw_data, ID3D11DeviceC
 }
 
 // Render function
+// Upload glyphs rasterized by ImFontAtlas::UpdateDynamicGlyphs() during ImGui::NewFrame() (ImFontAtlasFlags_DynamicGlyphs)
+static void ImGui_ImplDX11_UpdateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplDX11_Data* bd = ImGui_ImplDX11_GetBackendData();
+    ImFontAtlas* atlas = io.Fonts;
+    if (!atlas->IsTexDirty() || !bd->pFontTextureView)
+        return;
+
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ID3D11Resource* pTexture = NULL;
+    bd->pFontTextureView->GetResource(&pTexture);
+    D3D11_BOX box = { (UINT)atlas->TexDirtyX0, (UINT)atlas->TexDirtyY0, 0, (UINT)atlas->TexDirtyX1, (UINT)atlas->TexDirtyY1, 1 };
+    bd->pd3dDeviceContext->UpdateSubresource(pTexture, 0, &box, pixels + ((size_t)atlas->TexDirtyY0 * width + atlas->TexDirtyX0) * 4, width * 4, 0);
+    pTexture->Release();
+    atlas->ClearTexDirty();
+}
+
 void ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data)
 {
+    ImGui_ImplDX11_UpdateFontsTexture();
+
     // Avoid rendering when minimized
     if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
         return;
@@ -14,6 +14,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-18: OpenGL: Upload the font texture rectangle modified by ImFontAtlas::UpdateDynamicGlyphs() (ImFontAtlasFlags_DynamicGlyphs).
 //  2021-06-29: Reorganized backend to pull data from a single structure to facilitate usage with multiple-contexts (all g_XXXX access changed to bd->XXXX).
 //  2021-06-25: OpenGL: Use OES_vertex_array extension on Emscripten + backup/restore current state.
 //  2021-06-21: OpenGL: Destroy individual vertex/fragment shader objects right after they are linked into the main shader.
@@ -390,8 +391,34 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
+// Upload glyphs rasterized by ImFontAtlas::UpdateDynamicGlyphs() during ImGui::NewFrame() (ImFontAtlasFlags_DynamicGlyphs).
+// Whole rows are uploaded, as GL_UNPACK_ROW_LENGTH is not available on ES 2.0.
+static void ImGui_ImplOpenGL3_UpdateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImFontAtlas* atlas = io.Fonts;
+    if (!atlas->IsTexDirty() || !bd->FontTexture)
+        return;
+
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, bd->FontTexture);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, atlas->TexDirtyY0, width, atlas->TexDirtyY1 - atlas->TexDirtyY0, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)atlas->TexDirtyY0 * width * 4);
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+    atlas->ClearTexDirty();
+}
+
 void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 {
+    ImGui_ImplOpenGL3_UpdateFontsTexture();
+
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
     int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
     int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
@@ -0,0 +1,3 @@
+@REM Build for Visual Studio compiler. Run your copy of vcvars32.bat or vcvarsall.bat to setup command-line compiler.
+mkdir Release
+cl /nologo /O2 /MD /I ..\.. %* *.cpp ..\..\imgui.cpp ..\..\imgui_draw.cpp ..\..\imgui_tables.cpp ..\..\imgui_widgets.cpp /FeRelease/example_null_benchmarks.exe /FoRelease/ /link gdi32.lib shell32.lib imm32.lib
@@ -0,0 +1,705 @@
+// dear imgui: "null" benchmarks application
+// (compile and link imgui, create context, run headless with NO INPUTS, NO GRAPHICS OUTPUT)
+// Times core imgui functions and checks that their optimized paths give the same output as the reference ones.
+// Exits with 1 if any of those checks failed. Unlike example_null, this needs threads (pthreads or Win32) and C11 timespec_get().
+#include "imgui.h"
+#include "imgui_internal.h"
+#ifdef IMGUI_EXAMPLE_BENCHMARKS_IMNODES
+#include "imnodes.h"
+#endif
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Wall clock time, for timing work spread over several threads (clock() adds up the time of all threads)
+static double GetWallTimeMs()
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Worker threads for the multi-threaded tests (Dear ImGui has no threading layer, see e.g. ImFontAtlas::BuildParallelForFn)
+// Start() runs task_func(task_data, n) for every n in [0, tasks_count) on the threads, Join() waits for all tasks to complete.
+struct WorkerThreads
+{
+    enum { MaxThreads = 8 };
+    struct Worker { WorkerThreads* Owner; int Index; };
+    ImGuiTaskFunc TaskFunc;
+    void* TaskData;
+    int TasksCount;
+    int ThreadsCount;
+    Worker Workers[MaxThreads];
+#ifdef _WIN32
+    HANDLE Handles[MaxThreads];
+    static DWORD WINAPI ThreadMain(LPVOID arg) { Run((Worker*)arg); return 0; }
+#else
+    pthread_t Handles[MaxThreads];
+    static void* ThreadMain(void* arg) { Run((Worker*)arg); return NULL; }
+#endif
+    static void Run(Worker* worker)
+    {
+        WorkerThreads* threads = worker->Owner;
+        for (int n = worker->Index; n < threads->TasksCount; n += threads->ThreadsCount)
+            threads->TaskFunc(threads->TaskData, n);
+    }
+    void Start(int threads_count, int tasks_count, ImGuiTaskFunc task_func, void* task_data)
+    {
+        IM_ASSERT(threads_count > 0 && threads_count <= MaxThreads);
+        TaskFunc = task_func;
+        TaskData = task_data;
+        TasksCount = tasks_count;
+        ThreadsCount = threads_count;
+        for (int n = 0; n < threads_count; n++)
+        {
+            Workers[n].Owner = this;
+            Workers[n].Index = n;
+#ifdef _WIN32
+            Handles[n] = CreateThread(NULL, 0, ThreadMain, &Workers[n], 0, NULL);
+#else
+            pthread_create(&Handles[n], NULL, ThreadMain, &Workers[n]);
+#endif
+        }
+    }
+    void Join()
+    {
+        for (int n = 0; n < ThreadsCount; n++)
+        {
+#ifdef _WIN32
+            WaitForSingleObject(Handles[n], INFINITE);
+            CloseHandle(Handles[n]);
+#else
+            pthread_join(Handles[n], NULL);
+#endif
+        }
+    }
+};
+
+// Parallel-for with the signature of ImFontAtlas::BuildParallelForFn, 'user_data' points to the number of threads
+static void ParallelFor(void* user_data, int tasks_count, ImGuiTaskFunc task_func, void* task_data)
+{
+    WorkerThreads threads;
+    threads.Start(*(const int*)user_data, tasks_count, task_func, task_data);
+    threads.Join();
+}
+
+// ImStristr() as implemented before the IMGUI_ENABLE_SSE path and ImToLower(), as a baseline for the benchmark
+static const char* StristrBaseline(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
+{
+    if (!needle_end)
+        needle_end = needle + strlen(needle);
+
+    const char un0 = (char)toupper(*needle);
+    while ((!haystack_end && *haystack) || (haystack_end && haystack < haystack_end))
+    {
+        if (toupper(*haystack) == un0)
+        {
+            const char* b = needle + 1;
+            for (const char* a = haystack + 1; b < needle_end; a++, b++)
+                if (toupper(*a) != toupper(*b))
+                    break;
+            if (b == needle_end)
+                return haystack;
+        }
+        haystack++;
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+
+    // Build atlas
+    clock_t build_start = clock();
+    io.Fonts->AddFontDefault();
+    io.Fonts->Build();
+    clock_t build_end = clock();
+
+    // Startup time when restoring an identical atlas from a build cache saved by a previous run
+    ImVector<char> build_cache;
+    io.Fonts->SaveBuildCacheToMemory(&build_cache);
+    ImFontAtlas cached_atlas;
+    clock_t load_start = clock();
+    cached_atlas.AddFontDefault();
+    bool load_ok = cached_atlas.LoadBuildCacheFromMemory(build_cache.Data, (size_t)build_cache.Size);
+    clock_t load_end = clock();
+    printf("Font atlas: Build() %.3f ms, LoadBuildCacheFromMemory() %.3f ms (%s, %d KB)\n",
+        (build_end - build_start) * 1000.0 / CLOCKS_PER_SEC, (load_end - load_start) * 1000.0 / CLOCKS_PER_SEC, load_ok ? "ok" : "failed", build_cache.Size / 1024);
+
+    // Startup time of glyph rasterization: serial vs on worker threads (ImFontAtlas::BuildParallelForFn). The texture must be the same.
+    // - The default font at several sizes.
+    // - A TTF file with the union of all bundled glyph ranges (Chinese, Japanese, Korean, Cyrillic, Thai, Vietnamese), at two sizes.
+    //   Pass a CJK font as first argument (e.g. 'example_null_benchmarks NotoSansCJK-Regular.ttc') to measure a full CJK build, DroidSans.ttf is used by default.
+    bool parallel_build_identical = true;
+    {
+        const char* ranges_font_filename = (argc > 1) ? argv[1] : "../../misc/fonts/DroidSans.ttf";
+        size_t ranges_font_size = 0;
+        void* ranges_font_data = ImFileLoadToMemory(ranges_font_filename, "rb", &ranges_font_size);
+        ImVector<ImWchar> all_ranges;
+        ImFontGlyphRangesBuilder all_ranges_builder;
+        all_ranges_builder.AddRanges(io.Fonts->GetGlyphRangesChineseFull());
+        all_ranges_builder.AddRanges(io.Fonts->GetGlyphRangesJapanese());
+        all_ranges_builder.AddRanges(io.Fonts->GetGlyphRangesKorean());
+        all_ranges_builder.AddRanges(io.Fonts->GetGlyphRangesCyrillic());
+        all_ranges_builder.AddRanges(io.Fonts->GetGlyphRangesThai());
+        all_ranges_builder.AddRanges(io.Fonts->GetGlyphRangesVietnamese());
+        all_ranges_builder.BuildRanges(&all_ranges);
+
+        int threads_count = 4;
+        for (int build_case = 0; build_case < 2; build_case++)
+        {
+            if (build_case == 1 && ranges_font_data == NULL)
+            {
+                printf("Font atlas: could not load '%s', skipping the bundled glyph ranges build\n", ranges_font_filename);
+                continue;
+            }
+            double build_ms[2];
+            ImVector<unsigned char> tex_alpha[2];
+            int glyphs_count = 0;
+            for (int pass = 0; pass < 2; pass++)
+            {
+                const int reps_count = (build_case == 0) ? 5 : 2;
+                const double start = GetWallTimeMs();
+                for (int rep = 0; rep < reps_count; rep++)
+                {
+                    ImFontAtlas atlas;
+                    if (pass == 1)
+                    {
+                        atlas.BuildParallelForFn = ParallelFor;
+                        atlas.BuildParallelForUserData = &threads_count;
+                    }
+                    if (build_case == 0)
+                    {
+                        for (int size = 13; size <= 104; size *= 2)
+                        {
+                            ImFontConfig font_cfg;
+                            font_cfg.SizePixels = (float)size;
+                            font_cfg.OversampleH = 3;
+                            atlas.AddFontDefault(&font_cfg);
+                        }
+                    }
+                    else
+                    {
+                        for (int size = 16; size <= 32; size *= 2)
+                        {
+                            ImFontConfig font_cfg;
+                            font_cfg.FontDataOwnedByAtlas = false;
+                            atlas.AddFontFromMemoryTTF(ranges_font_data, (int)ranges_font_size, (float)size, &font_cfg, all_ranges.Data);
+                        }
+                    }
+                    atlas.Build();
+                    if (rep == 0)
+                    {
+                        unsigned char* pixels;
+                        int width, height;
+                        atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+                        tex_alpha[pass].resize(width * height);
+                        memcpy(tex_alpha[pass].Data, pixels, (size_t)tex_alpha[pass].Size);
+                        glyphs_count = 0;
+                        for (int font_n = 0; font_n < atlas.Fonts.Size; font_n++)
+                            glyphs_count += atlas.Fonts[font_n]->Glyphs.Size;
+                    }
+                }
+                build_ms[pass] = (GetWallTimeMs() - start) / reps_count;
+            }
+            const bool identical = tex_alpha[0].Size == tex_alpha[1].Size && memcmp(tex_alpha[0].Data, tex_alpha[1].Data, (size_t)tex_alpha[0].Size) == 0;
+            if (!identical)
+                parallel_build_identical = false;
+            printf("Font atlas: %s, %d glyphs: Build() %.3f ms (serial), %.3f ms (%d threads), texture %s\n",
+                (build_case == 0) ? "default font x4 sizes" : "bundled glyph ranges x2 sizes", glyphs_count, build_ms[0], build_ms[1], threads_count, identical ? "identical" : "differs");
+        }
+        IM_FREE(ranges_font_data);
+    }
+
+    // Text rendering throughput: batched path for runs of ASCII/Latin-1 characters, and per-glyph path (taken when passing a CPU fine clip rectangle).
+    // The per-glyph pass also pays for CPU clipping, so it is not a before/after comparison: run this against a build without the batched path for that.
+    {
+        ImGuiTextBuffer log;
+        for (int line = 0; line < 60; line++)
+            log.appendf("[%05d] [info] The quick brown fox jumps over the lazy dog, %d times.\n", line, line * 7);
+        ImDrawList draw_list(ImGui::GetDrawListSharedData());
+        const ImVec4 clip_rect(0.0f, 0.0f, 1920.0f, 1080.0f);
+        double glyphs_per_ms[2];
+        for (int pass = 0; pass < 2; pass++)
+        {
+            int glyphs_count = 0;
+            clock_t start = clock();
+            for (int n = 0; n < 1000; n++)
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.PushClipRect(ImVec2(clip_rect.x, clip_rect.y), ImVec2(clip_rect.z, clip_rect.w));
+                draw_list.AddText(io.Fonts->Fonts[0], 13.0f, ImVec2(0.0f, 0.0f), IM_COL32_WHITE, log.begin(), log.end(), 0.0f, (pass == 1) ? &clip_rect : NULL);
+                glyphs_count += draw_list.VtxBuffer.Size / 4;
+            }
+            clock_t end = clock();
+            glyphs_per_ms[pass] = glyphs_count / ((end - start) * 1000.0 / CLOCKS_PER_SEC + 1e-6);
+        }
+        printf("Text rendering: %.0f glyphs/ms (batched), %.0f glyphs/ms (per-glyph, CPU fine clip)\n", glyphs_per_ms[0], glyphs_per_ms[1]);
+    }
+
+    // ImGuiStorage: sorted storage vs hash index (SetUseHashIndex()), inserting then querying random keys
+    {
+        const int keys_counts[] = { 1000, 20000 };
+        for (int n = 0; n < IM_ARRAYSIZE(keys_counts); n++)
+        {
+            const int keys_count = keys_counts[n];
+            ImVector<ImGuiID> keys;
+            keys.resize(keys_count);
+            for (int key_n = 0; key_n < keys_count; key_n++)
+                keys[key_n] = (ImGuiID)(key_n + 1) * 2654435761u; // Distinct keys in random order
+            double set_ns[2], get_ns[2];
+            int mismatches = 0;
+            for (int pass = 0; pass < 2; pass++)
+            {
+                ImGuiStorage storage;
+                storage.SetUseHashIndex(pass == 1);
+                clock_t start = clock();
+                for (int key_n = 0; key_n < keys_count; key_n++)
+                    storage.SetInt(keys[key_n], key_n);
+                clock_t end = clock();
+                set_ns[pass] = (end - start) * 1e9 / CLOCKS_PER_SEC / keys_count;
+                const int reps = 2000000 / keys_count;
+                start = clock();
+                for (int rep = 0; rep < reps; rep++)
+                    for (int key_n = 0; key_n < keys_count; key_n++)
+                        mismatches += (storage.GetInt(keys[key_n], -1) != key_n);
+                end = clock();
+                get_ns[pass] = (end - start) * 1e9 / CLOCKS_PER_SEC / ((double)keys_count * reps);
+            }
+            printf("ImGuiStorage: %d keys, SetInt() new key %.1f ns (sorted), %.1f ns (hash index), GetInt() %.1f ns (sorted), %.1f ns (hash index), values %s\n",
+                keys_count, set_ns[0], set_ns[1], get_ns[0], get_ns[1], mismatches == 0 ? "ok" : "differ");
+        }
+    }
+
+    // ImHashStr() and ImHashData() throughput, for the hash function selected at compile time (build with -DIMGUI_USE_FAST_HASH to compare)
+    {
+        const int labels_count = 1000;
+        const int label_stride = 32;
+        ImVector<char> labels;
+        labels.resize(labels_count * label_stride);
+        for (int n = 0; n < labels_count; n++)
+        {
+            char* label = labels.Data + n * label_stride;
+            if (n % 3 == 0)
+                ImFormatString(label, label_stride, "Item %d", n);
+            else if (n % 3 == 1)
+                ImFormatString(label, label_stride, "Button##%d", n);
+            else
+                ImFormatString(label, label_stride, "Node %d###node_%d", n, n);
+        }
+        const int reps = 1000;
+        ImGuiID seed = 0;
+        clock_t start = clock();
+        for (int rep = 0; rep < reps; rep++)
+            for (int n = 0; n < labels_count; n++)
+                seed = ImHashStr(labels.Data + n * label_stride, 0, seed);
+        clock_t end = clock();
+        const double str_ns = (end - start) * 1e9 / CLOCKS_PER_SEC / ((double)labels_count * reps);
+        start = clock();
+        for (int rep = 0; rep < reps; rep++)
+            for (int n = 0; n < labels_count; n++)
+            {
+                // Same as PushID(int) then GetID(const void*)
+                const void* ptr = labels.Data + n * label_stride;
+                seed = ImHashData(&ptr, sizeof(ptr), ImHashData(&n, sizeof(n), seed));
+            }
+        end = clock();
+        const double data_ns = (end - start) * 1e9 / CLOCKS_PER_SEC / ((double)labels_count * reps);
+#ifdef IMGUI_USE_FAST_HASH
+        const char* hash_name = "IMGUI_USE_FAST_HASH";
+#else
+        const char* hash_name = "CRC32 table";
+#endif
+        printf("ImHashStr(): %.1f ns/label, ImHashData(): %.1f ns/int+ptr ID (%s, last ID 0x%08X)\n", str_ns, data_ns, hash_name, seed);
+    }
+
+    // ImStristr() vs the previous toupper() loop, and ImGuiTextFilterCache vs ImGuiTextFilter::PassFilter() on every item, typing a filter one character at a time
+    bool filter_output_identical = true;
+    {
+        const int items_count = 100000;
+        ImGuiTextBuffer items_buf;
+        ImVector<int> items_offsets;
+        items_offsets.reserve(items_count + 1);
+        for (int n = 0; n < items_count; n++)
+        {
+            items_offsets.push_back(items_buf.size());
+            switch (n % 4)
+            {
+            case 0: items_buf.appendf("assets/characters/hero_%05d.png", n); break;
+            case 1: items_buf.appendf("assets/props/Crate_%05d.dds", n); break;
+            case 2: items_buf.appendf("assets/levels/level_%03d/terrain_%05d.mesh", n % 100, n); break;
+            case 3: items_buf.appendf("assets/ui/HERO_icon_%05d.png", n); break;
+            }
+        }
+        items_offsets.push_back(items_buf.size());
+
+        // ImStristr()
+        const char* needle = "hero_00";
+        double stristr_ns[2];
+        int stristr_results[2] = { 0, 0 };
+        for (int pass = 0; pass < 2; pass++)
+        {
+            clock_t start = clock();
+            for (int rep = 0; rep < 10; rep++)
+                for (int n = 0; n < items_count; n++)
+                {
+                    const char* text = items_buf.begin() + items_offsets[n];
+                    const char* text_end = items_buf.begin() + items_offsets[n + 1];
+                    const char* found = (pass == 0) ? ImStristr(text, text_end, needle, NULL) : StristrBaseline(text, text_end, needle, NULL);
+                    stristr_results[pass] += found ? (int)(found - text) + 1 : 0;
+                }
+            clock_t end = clock();
+            stristr_ns[pass] = (end - start) * 1e9 / CLOCKS_PER_SEC / (items_count * 10.0);
+        }
+        if (stristr_results[0] != stristr_results[1])
+            filter_output_identical = false;
+#ifdef IMGUI_ENABLE_SSE
+        const char* stristr_name = "SSE";
+#else
+        const char* stristr_name = "scalar";
+#endif
+        printf("ImStristr(): %.1f ns/item (%s), %.1f ns/item (toupper() loop), results %s\n", stristr_ns[0], stristr_name, stristr_ns[1], stristr_results[0] == stristr_results[1] ? "identical" : "differ");
+
+        // ImGuiTextFilterCache: incremental narrowing vs a full rescan on every keystroke
+        const char* typed = "hero_0000";
+        const int keystrokes_count = (int)strlen(typed);
+        ImGuiTextFilter filter;
+        ImGuiTextFilterCache filter_cache;
+        double typing_ms[2];
+        ImVector<int> pass_counts[2];
+        for (int pass = 0; pass < 2; pass++)
+        {
+            filter_cache.Clear();
+            clock_t start = clock();
+            for (int keystroke = 1; keystroke <= keystrokes_count; keystroke++)
+            {
+                ImStrncpy(filter.InputBuf, typed, (size_t)keystroke + 1);
+                filter.Build();
+                if (pass == 1)
+                    filter_cache.Update(&filter, items_count);
+                int pass_count = 0;
+                for (int n = 0; n < items_count; n++)
+                {
+                    const char* text = items_buf.begin() + items_offsets[n];
+                    const char* text_end = items_buf.begin() + items_offsets[n + 1];
+                    pass_count += (pass == 0) ? filter.PassFilter(text, text_end) : filter_cache.PassFilter(n, text, text_end);
+                }
+                pass_counts[pass].push_back(pass_count);
+            }
+            clock_t end = clock();
+            typing_ms[pass] = (end - start) * 1000.0 / CLOCKS_PER_SEC;
+        }
+        const bool cache_output_identical = pass_counts[0].Size == pass_counts[1].Size && memcmp(pass_counts[0].Data, pass_counts[1].Data, (size_t)pass_counts[0].size_in_bytes()) == 0;
+        if (!cache_output_identical)
+            filter_output_identical = false;
+
+        // Following frames with an unchanged filter
+        const int frames_count = 10;
+        clock_t start = clock();
+        for (int frame = 0; frame < frames_count; frame++)
+        {
+            filter_cache.Update(&filter, items_count);
+            for (int n = 0; n < items_count; n++)
+                filter_cache.PassFilter(n, items_buf.begin() + items_offsets[n], items_buf.begin() + items_offsets[n + 1]);
+        }
+        clock_t end = clock();
+        const double cached_frame_ms = (end - start) * 1000.0 / CLOCKS_PER_SEC / frames_count;
+        printf("ImGuiTextFilterCache: %d items, typing \"%s\": %.3f ms (full rescan), %.3f ms (cache, narrowing), unchanged filter %.3f ms/frame, results %s\n",
+            items_count, typed, typing_ms[0], typing_ms[1], cached_frame_ms, cache_output_identical ? "identical" : "differ");
+    }
+
+    // SSE vs scalar paths of anti-aliased AddConvexPolyFilled() and AddPolyline(): both must output the same vertices and indices
+    bool sse_output_identical = true;
+    {
+        ImDrawListSharedData* shared_data = ImGui::GetDrawListSharedData();
+        ImDrawList sse_draw_list(shared_data);
+        ImDrawList scalar_draw_list(shared_data);
+        ImDrawList* draw_lists[2] = { &sse_draw_list, &scalar_draw_list };
+        const int points_counts[] = { 3, 4, 5, 7, 8, 9, 16, 17, 33, 100, 1000, 10000, 100000 };
+        ImVector<ImVec2> points;
+        int shapes_count = 0;
+        for (int n = 0; n < IM_ARRAYSIZE(points_counts); n++)
+            for (int shape = 0; shape < 3; shape++) // Circle, circle with repeated points, single point
+                for (int fringe = 0; fringe < 2; fringe++)
+                {
+                    points.resize(points_counts[n]);
+                    for (int i = 0; i < points.Size; i++)
+                    {
+                        const float a = ((shape == 1 ? (i & ~1) : i) * 2 * IM_PI) / points.Size;
+                        points[i] = (shape == 2) ? ImVec2(10.0f, 10.0f) : ImVec2(100.0f + ImCos(a) * 50.0f, 100.0f + ImSin(a) * 50.0f);
+                    }
+                    for (int pass = 0; pass < 2; pass++)
+                    {
+                        ImDrawList* draw_list = draw_lists[pass];
+                        shared_data->DisableSSE = (pass == 1);
+                        draw_list->_ResetForNewFrame();
+                        draw_list->Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill;
+                        draw_list->_FringeScale = fringe ? 0.5f : 1.0f;
+                        draw_list->AddConvexPolyFilled(points.Data, points.Size, IM_COL32_WHITE);
+                        draw_list->AddPolyline(points.Data, points.Size, IM_COL32_WHITE, ImDrawFlags_None, 1.0f);
+                        draw_list->AddPolyline(points.Data, points.Size, IM_COL32_WHITE, ImDrawFlags_Closed, 1.0f);
+                        draw_list->AddPolyline(points.Data, points.Size, IM_COL32_WHITE, ImDrawFlags_None, 3.5f);
+                        draw_list->AddPolyline(points.Data, points.Size, IM_COL32_WHITE, ImDrawFlags_Closed, 3.5f);
+                    }
+                    shared_data->DisableSSE = false;
+                    if (sse_draw_list.VtxBuffer.Size != scalar_draw_list.VtxBuffer.Size || sse_draw_list.IdxBuffer.Size != scalar_draw_list.IdxBuffer.Size ||
+                        memcmp(sse_draw_list.VtxBuffer.Data, scalar_draw_list.VtxBuffer.Data, (size_t)sse_draw_list.VtxBuffer.size_in_bytes()) != 0 ||
+                        memcmp(sse_draw_list.IdxBuffer.Data, scalar_draw_list.IdxBuffer.Data, (size_t)sse_draw_list.IdxBuffer.size_in_bytes()) != 0)
+                    {
+                        printf("SSE vs scalar: mismatch with %d points (shape %d, fringe scale %.1f)\n", points.Size, shape, sse_draw_list._FringeScale);
+                        sse_output_identical = false;
+                    }
+                    shapes_count++;
+                }
+        printf("SSE vs scalar: %d shapes compared, output %s\n", shapes_count, sse_output_identical ? "identical" : "differs");
+    }
+
+    // Polyline tessellation throughput: SSE path (with IMGUI_ENABLE_SSE) vs scalar path of anti-aliased AddPolyline(), for thin and thick lines, from 4 to 100k points
+    {
+        ImDrawListSharedData* shared_data = ImGui::GetDrawListSharedData();
+        ImDrawList draw_list(shared_data);
+        const int points_counts[] = { 4, 16, 100, 1000, 10000, 100000 };
+        const float thicknesses[] = { 1.0f, 4.0f };
+        ImVector<ImVec2> points;
+        for (int n = 0; n < IM_ARRAYSIZE(points_counts); n++)
+        {
+            points.resize(0);
+            for (int i = 0; i < points_counts[n]; i++)
+                points.push_back(ImVec2(i * 1900.0f / points_counts[n], 540.0f + ImSin(i * 0.05f) * 400.0f));
+            const int reps = ImMax(1000000 / points.Size, 10);
+            double points_per_ms[IM_ARRAYSIZE(thicknesses)][2];
+            for (int thickness_n = 0; thickness_n < IM_ARRAYSIZE(thicknesses); thickness_n++)
+                for (int pass = 0; pass < 2; pass++)
+                {
+                    shared_data->DisableSSE = (pass == 1);
+                    clock_t start = clock();
+                    for (int rep = 0; rep < reps; rep++)
+                    {
+                        draw_list._ResetForNewFrame();
+                        draw_list.Flags = ImDrawListFlags_AntiAliasedLines;
+                        draw_list.AddPolyline(points.Data, points.Size, IM_COL32_WHITE, ImDrawFlags_None, thicknesses[thickness_n]);
+                    }
+                    clock_t end = clock();
+                    points_per_ms[thickness_n][pass] = (double)points.Size * reps / ((end - start) * 1000.0 / CLOCKS_PER_SEC + 1e-6);
+                }
+            shared_data->DisableSSE = false;
+            printf("AddPolyline() anti-aliased, %6d points: thin %.0f (SSE) / %.0f (scalar), thick %.0f (SSE) / %.0f (scalar) points/ms\n",
+                points.Size, points_per_ms[0][0], points_per_ms[0][1], points_per_ms[1][0], points_per_ms[1][1]);
+        }
+    }
+
+    // Deferred draw lists: 64 windows filled by worker threads while the main thread keeps submitting windows (changing the current font size).
+    // The draw data of the last frame must be the same whatever the number of threads.
+    // The draw lists are created every frame, so worker threads always grow empty buffers (allocations happen on the worker threads).
+    bool deferred_output_identical = true;
+    {
+        const int windows_count = 64;
+        const int frames_count = 10;
+        static ImDrawList* deferred_draw_lists[windows_count];
+        static ImVec2 deferred_origins[windows_count];
+        struct DeferredContents
+        {
+            static void Fill(int window_n)
+            {
+                ImDrawList* draw_list = deferred_draw_lists[window_n];
+                const ImVec2 origin = deferred_origins[window_n];
+                for (int n = 0; n < 100; n++)
+                {
+                    const ImVec2 p(origin.x + (n % 10) * 20.0f + 10.0f, origin.y + (n / 10) * 12.0f + 100.0f);
+                    draw_list->AddCircleFilled(p, 5.0f, IM_COL32(n * 2, 255 - n * 2, window_n * 4, 255), 12);
+                    draw_list->AddLine(p, ImVec2(p.x + 15.0f, p.y + 8.0f), IM_COL32_WHITE, 2.0f);
+                }
+                for (int line = 0; line < 6; line++)
+                    draw_list->AddText(ImVec2(origin.x, origin.y + line * 16.0f), IM_COL32_WHITE, "The quick brown fox jumps over the lazy dog"); // Uses the font and size of the draw list shared data
+            }
+            static void FillTask(void*, int window_n) { Fill(window_n); }
+        };
+        const int threads_counts[] = { 4, 0 };
+        ImU32 draw_data_hashes[2] = { 0, 0 };
+        double ms_per_frame[2];
+        int vtx_count = 0;
+        for (int pass = 0; pass < 2; pass++)
+        {
+            const int threads_count = threads_counts[pass];
+            const double start = GetWallTimeMs();
+            for (int frame = 0; frame < frames_count; frame++)
+            {
+                io.DisplaySize = ImVec2(1920, 1080);
+                io.DeltaTime = 1.0f / 60.0f;
+                ImGui::NewFrame();
+                for (int n = 0; n < windows_count; n++)
+                    deferred_draw_lists[n] = IM_NEW(ImDrawList)(NULL);
+                for (int n = 0; n < windows_count; n++)
+                {
+                    char name[32];
+                    ImFormatString(name, IM_ARRAYSIZE(name), "Deferred %d", n);
+                    ImGui::SetNextWindowPos(ImVec2((n % 8) * 240.0f, (n / 8) * 135.0f));
+                    ImGui::SetNextWindowSize(ImVec2(240.0f, 135.0f));
+                    ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings);
+                    deferred_origins[n] = ImGui::GetCursorScreenPos();
+                    ImGui::AddDeferredDrawList(deferred_draw_lists[n]);
+                    ImGui::End();
+                }
+                WorkerThreads threads;
+                if (threads_count > 0)
+                    threads.Start(threads_count, windows_count, DeferredContents::FillTask, NULL);
+                ImGui::Begin("Main thread", NULL, ImGuiWindowFlags_NoSavedSettings);
+                for (int n = 0; n < windows_count; n++)
+                {
+                    ImGui::SetWindowFontScale(1.0f + (n % 4) * 0.25f);
+                    ImGui::Text("Main thread line %d", n);
+                    if (threads_count == 0)
+                        DeferredContents::Fill(n); // Without threads, fill while the current font size differs from the one when AddDeferredDrawList() was called
+                }
+                ImGui::End();
+                if (threads_count > 0)
+                    threads.Join();
+                ImGui::Render();
+
+                // Windows appearing in the first frames of the first pass have a different layout, so only the last frame is compared
+                ImDrawData* draw_data = ImGui::GetDrawData();
+                ImU32 hash = 0;
+                vtx_count = draw_data->TotalVtxCount;
+                for (int n = 0; n < draw_data->CmdListsCount; n++)
+                {
+                    const ImDrawList* draw_list = draw_data->CmdLists[n];
+                    hash = ImHashData(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes(), hash);
+                    hash = ImHashData(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), hash);
+                    for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+                        hash = ImHashData(&draw_list->CmdBuffer[cmd_n].ElemCount, sizeof(unsigned int), hash);
+                }
+                draw_data_hashes[pass] = hash;
+                for (int n = 0; n < windows_count; n++)
+                    IM_DELETE(deferred_draw_lists[n]);
+            }
+            ms_per_frame[pass] = (GetWallTimeMs() - start) / frames_count;
+        }
+        deferred_output_identical = draw_data_hashes[0] == draw_data_hashes[1];
+        printf("Deferred draw lists: %d windows, %d vertices, %.3f ms/frame (%d threads), %.3f ms/frame (main thread), output %s\n",
+            windows_count, vtx_count, ms_per_frame[0], threads_counts[0], ms_per_frame[1], deferred_output_identical ? "identical" : "differs");
+    }
+
+    // Wide tables: 10k rows clipped with ImGuiListClipper, horizontal scrolling (IMGUI_TABLE_MAX_COLUMNS is 64)
+    // Without frozen rows/columns, draw channels are merged without reordering them (see TableMergeDrawChannels()).
+    const int wide_table_columns[] = { 16, 32, 64 };
+    for (int n = 0; n < IM_ARRAYSIZE(wide_table_columns); n++)
+    {
+        const int columns_count = wide_table_columns[n];
+        const int frames_count = 200;
+        double ms_per_frame[2];
+        for (int freeze = 0; freeze < 2; freeze++)
+        {
+            clock_t start = clock();
+            for (int frame = 0; frame < frames_count; frame++)
+            {
+                io.DisplaySize = ImVec2(1920, 1080);
+                io.DeltaTime = 1.0f / 60.0f;
+                ImGui::NewFrame();
+                ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+                ImGui::SetNextWindowSize(io.DisplaySize);
+                ImGui::Begin("Wide table", NULL, ImGuiWindowFlags_NoSavedSettings);
+                ImGui::PushID(columns_count * 2 + freeze);
+                if (ImGui::BeginTable("table", columns_count, ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Hideable))
+                {
+                    if (freeze)
+                        ImGui::TableSetupScrollFreeze(1, 1);
+                    if (frame == 0)
+                    {
+                        ImGui::SetScrollX(400.0f); // Frozen rows/columns are only applied when scrolled
+                        ImGui::SetScrollY(4000.0f);
+                    }
+                    for (int column = 0; column < columns_count; column++)
+                    {
+                        char label[16];
+                        ImFormatString(label, IM_ARRAYSIZE(label), "Column %d", column);
+                        ImGui::TableSetupColumn(label, ImGuiTableColumnFlags_WidthFixed, 80.0f);
+                    }
+                    ImGui::TableHeadersRow();
+                    ImGuiListClipper clipper;
+                    clipper.Begin(10000);
+                    while (clipper.Step())
+                        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                        {
+                            ImGui::TableNextRow();
+                            for (int column = 0; column < columns_count; column++)
+                                if (ImGui::TableSetColumnIndex(column))
+                                    ImGui::Text("Cell %d,%d", row, column);
+                        }
+                    ImGui::EndTable();
+                }
+                ImGui::PopID();
+                ImGui::End();
+                ImGui::Render();
+            }
+            clock_t end = clock();
+            ms_per_frame[freeze] = (end - start) * 1000.0 / CLOCKS_PER_SEC / frames_count;
+        }
+        printf("Wide table: %d columns x 10000 rows, %.3f ms/frame (no frozen rows/columns), %.3f ms/frame (1 frozen row and column)\n", columns_count, ms_per_frame[0], ms_per_frame[1]);
+    }
+
+#ifdef IMGUI_EXAMPLE_BENCHMARKS_IMNODES
+    // Node editor: clicking a node brings it to front, after which the node draw channels are reordered by depth every frame
+    ImNodes::CreateContext();
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset; // Large graphs don't fit in 64K vertices
+    const int node_editor_nodes[] = { 1000, 10000 };
+    for (int n = 0; n < IM_ARRAYSIZE(node_editor_nodes); n++)
+    {
+        const int nodes_count = node_editor_nodes[n];
+        const int frames_count = 20;
+        ImNodesEditorContext* editor = ImNodes::EditorContextCreate();
+        ImNodes::EditorContextSet(editor);
+        for (int node = 0; node < nodes_count; node++)
+            ImNodes::SetNodeGridSpacePos(node, ImVec2((node % 100) * 140.0f, (node / 100) * 110.0f));
+        clock_t start = clock();
+        for (int frame = 0; frame < frames_count; frame++)
+        {
+            const int clicked_node = (frame / 2) % 10;
+            io.DisplaySize = ImVec2(1920, 1080);
+            io.DeltaTime = 1.0f / 60.0f;
+            const ImVec2 clicked_node_pos = ImNodes::GetNodeScreenSpacePos(clicked_node);
+            io.MousePos = ImVec2(clicked_node_pos.x + 4.0f, clicked_node_pos.y + 4.0f);
+            io.MouseDown[0] = (frame & 1) != 0;
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+            ImGui::SetNextWindowSize(io.DisplaySize);
+            ImGui::Begin("Node editor", NULL, ImGuiWindowFlags_NoSavedSettings);
+            ImNodes::BeginNodeEditor();
+            for (int node = 0; node < nodes_count; node++)
+            {
+                ImNodes::BeginNode(node);
+                ImNodes::BeginNodeTitleBar();
+                ImGui::Text("Node %d", node);
+                ImNodes::EndNodeTitleBar();
+                ImNodes::BeginInputAttribute(node * 2);
+                ImGui::TextUnformatted("in");
+                ImNodes::EndInputAttribute();
+                ImNodes::BeginOutputAttribute(node * 2 + 1);
+                ImGui::TextUnformatted("out");
+                ImNodes::EndOutputAttribute();
+                ImNodes::EndNode();
+            }
+            ImNodes::EndNodeEditor();
+            ImGui::End();
+            ImGui::Render();
+        }
+        clock_t end = clock();
+        printf("Node editor: %d nodes, bring to front, %.3f ms/frame\n", nodes_count, (end - start) * 1000.0 / CLOCKS_PER_SEC / frames_count);
+        ImNodes::EditorContextFree(editor);
+    }
+    io.MouseDown[0] = false;
+    ImNodes::DestroyContext();
+#endif
+
+    printf("DestroyContext()\n");
+    ImGui::DestroyContext();
+    return (parallel_build_identical && filter_output_identical && sse_output_identical && deferred_output_identical) ? 0 : 1;
+}
@@ -47,6 +47,11 @@
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
 
+//---- Use a faster hash for IDs (ImHashStr/ImHashData) instead of the table based CRC32.
+// Uses hardware CRC32C when compiling with SSE 4.2 (e.g. '-msse4.2') or ARMv8 CRC extension, and a portable multiply-mix hash otherwise.
+// IDs are stable within a build but differ from the default ones: settings stored by ID in .ini files (e.g. tables) won't be matched after switching.
+//#define IMGUI_USE_FAST_HASH
+
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
 
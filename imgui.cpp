@@ -61,8 +61,8 @@ CODE
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 // [SECTION] MISC HELPERS/UTILITIES (Color functions)
 // [SECTION] ImGuiStorage
-// [SECTION] ImGuiTextFilter
-// [SECTION] ImGuiTextBuffer
+// [SECTION] ImGuiTextFilter, ImGuiTextFilterCache
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -784,6 +784,9 @@ CODE
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#ifdef _MSC_VER
+#include <intrin.h>     // _InterlockedExchangeAdd
+#endif
 
 // [Windows] OS specific includes (optional)
 #if defined(_WIN32) && defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) && defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) && defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
@@ -880,6 +883,9 @@ static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* wind
 static void             AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
 static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
 
+// Text layout cache
+static const ImGuiTextLayoutCacheEntry* GetTextLayout(ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end);
+
 // Settings
 static void             WindowSettingsHandler_ClearAll(ImGuiContext*, ImGuiSettingsHandler*);
 static void*            WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
@@ -1092,6 +1098,9 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigDrawListShapeCache = false;
+    ConfigWindowsStorageUseHashIndex = false;
+    ConfigTextLayoutCache = false;
 
     // Platform Functions
     BackendPlatformName = BackendRendererName = NULL;
@@ -1369,19 +1378,60 @@ const ImWchar* ImStrbolW(const ImWchar* buf_mid_line, const ImWchar* buf_begin)
     return buf_mid_line;
 }
 
+#ifdef IMGUI_ENABLE_SSE
+// Fold 'A'-'Z' to lower case in 16 characters at once
+static inline __m128i ImSseToLowerA(__m128i v)
+{
+    const __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), v));
+    return _mm_or_si128(v, _mm_and_si128(is_upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
 const char* ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
 {
     if (!needle_end)
         needle_end = needle + strlen(needle);
 
-    const char un0 = (char)toupper(*needle);
+#ifdef IMGUI_ENABLE_SSE
+    // Compare the first and last characters of the needle against 16 positions at once, and only verify the rest of the
+    // needle at positions where both match. Positions too close to the end for a full 16 bytes load fall back to the loop below.
+    const size_t needle_len = (size_t)(needle_end - needle);
+    if (needle_len > 0)
+    {
+        if (!haystack_end)
+            haystack_end = haystack + strlen(haystack);
+        const __m128i v_first = _mm_set1_epi8(ImToLower(needle[0]));
+        const __m128i v_last = _mm_set1_epi8(ImToLower(needle_end[-1]));
+        while ((size_t)(haystack_end - haystack) >= needle_len + 15)
+        {
+            const __m128i block_first = ImSseToLowerA(_mm_loadu_si128((const __m128i*)(const void*)haystack));
+            const __m128i block_last = ImSseToLowerA(_mm_loadu_si128((const __m128i*)(const void*)(haystack + needle_len - 1)));
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, v_first), _mm_cmpeq_epi8(block_last, v_last)));
+            for (const char* candidate = haystack; mask != 0; candidate++, mask >>= 1)
+            {
+                if ((mask & 1) == 0)
+                    continue;
+                const char* a = candidate + 1;
+                const char* b = needle + 1;
+                for (; b < needle_end - 1; a++, b++)
+                    if (ImToLower(*a) != ImToLower(*b))
+                        break;
+                if (b >= needle_end - 1)
+                    return candidate;
+            }
+            haystack += 16;
+        }
+    }
+#endif
+
+    const char un0 = ImToLower(*needle);
     while ((!haystack_end && *haystack) || (haystack_end && haystack < haystack_end))
     {
-        if (toupper(*haystack) == un0)
+        if (ImToLower(*haystack) == un0)
         {
             const char* b = needle + 1;
             for (const char* a = haystack + 1; b < needle_end; a++, b++)
-                if (toupper(*a) != toupper(*b))
+                if (ImToLower(*a) != ImToLower(*b))
                     break;
             if (b == needle_end)
                 return haystack;
@@ -1466,6 +1516,8 @@ int ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args)
 }
 #endif // #ifdef IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS
 
+#ifndef IMGUI_USE_FAST_HASH
+
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -1535,6 +1587,95 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     }
     return ~crc;
 }
+#else // #ifndef IMGUI_USE_FAST_HASH
+
+// Fast hash (see IMGUI_USE_FAST_HASH in imconfig.h): same interface and "###" semantic, but IDs differ from the default CRC32.
+// - Hardware CRC32C when compiling for SSE 4.2 or ARMv8 CRC extension: 8 bytes per instruction, no lookup table.
+// - Otherwise, a multiply-mix hash processing 8 bytes per step.
+#if defined(__SSE4_2__) && !defined(IMGUI_DISABLE_SSE)
+#include <nmmintrin.h>
+#define IMGUI_HASH_CRC32C_SSE42
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define IMGUI_HASH_CRC32C_ARM
+#endif
+
+static inline ImU32 ImHashFast(const unsigned char* data, size_t data_size, ImU32 seed)
+{
+#if defined(IMGUI_HASH_CRC32C_SSE42) || defined(IMGUI_HASH_CRC32C_ARM)
+    ImU32 crc = ~seed;
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+#if defined(IMGUI_HASH_CRC32C_ARM)
+        crc = __crc32cd(crc, v);
+#elif defined(__x86_64__) || defined(_M_X64)
+        crc = (ImU32)_mm_crc32_u64(crc, v);
+#else
+        crc = _mm_crc32_u32(_mm_crc32_u32(crc, (ImU32)v), (ImU32)(v >> 32));
+#endif
+    }
+    for (; data_size > 0; data++, data_size--)
+    {
+#if defined(IMGUI_HASH_CRC32C_ARM)
+        crc = __crc32cb(crc, *data);
+#else
+        crc = _mm_crc32_u8(crc, *data);
+#endif
+    }
+    return ~crc;
+#else
+    if (data_size == 0)
+        return seed;
+    ImU64 h = seed ^ ((ImU64)data_size * 0x9E3779B97F4A7C15ULL);
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        h = (h ^ v) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+    }
+    if (data_size > 0)
+    {
+        ImU64 v = 0;
+        memcpy(&v, data, data_size);
+        h = (h ^ v) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+    }
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 29;
+    return (ImU32)h;
+#endif
+}
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+    return ImHashFast((const unsigned char*)data_p, data_size, seed);
+}
+
+// Zero-terminated string hash, with support for ### to reset back to seed value
+// Resetting to seed on each "###" is the same as only hashing from the last "###", which we locate with memchr() before hashing.
+ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
+{
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const char* data_begin = data_p;
+    const char* data_end = data_p + data_size;
+    for (const char* p = data_p; data_end - p >= 3; p++)
+    {
+        p = (const char*)memchr(p, '#', (size_t)(data_end - p - 2));
+        if (p == NULL)
+            break;
+        if (p[1] == '#' && p[2] == '#')
+            data_begin = p;
+    }
+    return ImHashFast((const unsigned char*)data_begin, (size_t)(data_end - data_begin), seed);
+}
+
+#endif // #ifndef IMGUI_USE_FAST_HASH
 
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
@@ -1674,8 +1815,11 @@ int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const cha
     ImWchar* buf_end = buf + buf_size;
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
-        unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        unsigned int c = (unsigned char)*in_text;
+        if (c < 0x80)
+            in_text++;
+        else
+            in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         if (c == 0)
             break;
         *buf_out++ = (ImWchar)c;
@@ -1902,6 +2046,69 @@ static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiSt
     return first;
 }
 
+// Hash index: open addressing with linear probing, kept at most half full.
+// Keys are generally already hashes but may be sequential (e.g. user indices), so we scramble them before masking.
+static inline int HashIndexFirstSlot(ImGuiID key, int index_size)
+{
+    ImU32 h = key * 0x9E3779B1u;
+    return (int)((h ^ (h >> 15)) & (ImU32)(index_size - 1));
+}
+
+// Return index of slot holding 'key', or of the empty slot where it would be inserted
+static int HashIndexFindSlot(const ImGuiStorage* storage, ImGuiID key)
+{
+    const int mask = storage->HashIndex.Size - 1;
+    for (int slot = HashIndexFirstSlot(key, storage->HashIndex.Size); ; slot = (slot + 1) & mask)
+    {
+        const int data_idx = storage->HashIndex.Data[slot];
+        if (data_idx == 0 || storage->Data.Data[data_idx - 1].key == key)
+            return slot;
+    }
+}
+
+static void HashIndexRebuild(ImGuiStorage* storage, int index_size)
+{
+    storage->HashIndex.resize(index_size);
+    memset(storage->HashIndex.Data, 0, (size_t)storage->HashIndex.size_in_bytes());
+    for (int n = 0; n < storage->Data.Size; n++)
+        storage->HashIndex[HashIndexFindSlot(storage, storage->Data[n].key)] = n + 1;
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    if (storage->UseHashIndex)
+    {
+        if (storage->HashIndex.Size == 0)
+            return NULL;
+        const int data_idx = storage->HashIndex.Data[HashIndexFindSlot(storage, key)];
+        return data_idx ? &storage->Data.Data[data_idx - 1] : NULL;
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStorage::ImGuiStoragePair>&>(storage->Data), key);
+    return (it == storage->Data.end() || it->key != key) ? NULL : it;
+}
+
+// 'default_pair' is inserted if 'key' is missing
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrInsert(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& default_pair)
+{
+    const ImGuiID key = default_pair.key;
+    if (storage->UseHashIndex)
+    {
+        if ((storage->Data.Size + 1) * 2 > storage->HashIndex.Size)
+            HashIndexRebuild(storage, storage->HashIndex.Size ? storage->HashIndex.Size * 2 : 16);
+        const int slot = HashIndexFindSlot(storage, key);
+        if (storage->HashIndex.Data[slot] == 0)
+        {
+            storage->Data.push_back(default_pair);
+            storage->HashIndex.Data[slot] = storage->Data.Size;
+        }
+        return &storage->Data.Data[storage->HashIndex.Data[slot] - 1];
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(storage->Data, key);
+    if (it == storage->Data.end() || it->key != key)
+        it = storage->Data.insert(it, default_pair);
+    return it;
+}
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
@@ -1917,14 +2124,23 @@ void ImGuiStorage::BuildSortByKey()
     };
     if (Data.Size > 1)
         ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairCompareByID);
+    if (UseHashIndex)
+        HashIndexRebuild(this, ImUpperPowerOfTwo(ImMax(Data.Size * 2, 16)));
+}
+
+void ImGuiStorage::SetUseHashIndex(bool use_hash_index)
+{
+    if (UseHashIndex == use_hash_index)
+        return;
+    UseHashIndex = use_hash_index;
+    HashIndex.clear();
+    BuildSortByKey(); // Sorted storage needs it, hash index is rebuilt by it
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -1934,27 +2150,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -1964,30 +2173,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_i = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -1997,24 +2193,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_f = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_p = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -2024,7 +2208,7 @@ void ImGuiStorage::SetAllInt(int v)
 }
 
 //-----------------------------------------------------------------------------
-// [SECTION] ImGuiTextFilter
+// [SECTION] ImGuiTextFilter, ImGuiTextFilterCache
 //-----------------------------------------------------------------------------
 
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
@@ -2125,8 +2309,71 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+ImGuiTextFilterCache::ImGuiTextFilterCache()
+{
+    Filter = NULL;
+    Generation = NarrowGeneration = 1;
+}
+
+bool ImGuiTextFilterCache::Update(const ImGuiTextFilter* filter, int items_count)
+{
+    IM_ASSERT(filter != NULL && items_count >= 0);
+    if (filter != Filter)
+        InvalidateAll();
+    Filter = filter;
+
+    // New items are evaluated lazily
+    if (ItemStates.Size != items_count)
+    {
+        const int old_count = ItemStates.Size;
+        ItemStates.resize(items_count);
+        if (items_count > old_count)
+            memset(ItemStates.Data + old_count, 0, (size_t)(items_count - old_count) * sizeof(int));
+    }
+
+    const int old_len = FilterText.Size ? FilterText.Size - 1 : 0;
+    const int new_len = (int)strlen(filter->InputBuf);
+    if (FilterText.Size != 0 && old_len == new_len && memcmp(FilterText.Data, filter->InputBuf, (size_t)new_len) == 0)
+        return false;
+
+    // Characters appended to a non-empty search term (not an exclusion) in last position can only reject more items.
+    // (earlier terms are unchanged, and text containing the longer term also contains the shorter one)
+    bool narrowing = false;
+    if (old_len > 0 && new_len > old_len && memcmp(FilterText.Data, filter->InputBuf, (size_t)old_len) == 0 && memchr(filter->InputBuf + old_len, ',', (size_t)(new_len - old_len)) == NULL)
+    {
+        const char* term = FilterText.Data;
+        for (const char* p = FilterText.Data; p < FilterText.Data + old_len; p++)
+            if (*p == ',')
+                term = p + 1;
+        while (term < FilterText.Data + old_len && ImCharIsBlankA(term[0]))
+            term++;
+        narrowing = (term < FilterText.Data + old_len && term[0] != '-');
+    }
+
+    FilterText.resize(new_len + 1);
+    memcpy(FilterText.Data, filter->InputBuf, (size_t)new_len + 1);
+    Generation++;
+    if (!narrowing)
+        NarrowGeneration = Generation;
+    return true;
+}
+
+bool ImGuiTextFilterCache::PassFilter(int item_idx, const char* text, const char* text_end)
+{
+    IM_ASSERT(Filter != NULL && item_idx >= 0 && item_idx < ItemStates.Size && "Call Update() first!");
+    int& state = ItemStates.Data[item_idx];
+    const int item_generation = state >> 1;
+    if (item_generation == Generation)
+        return (state & 1) != 0;
+
+    // Items rejected by a wider version of the current filter remain rejected
+    const bool pass = (item_generation >= NarrowGeneration && (state & 1) == 0) ? false : Filter->PassFilter(text, text_end);
+    state = (Generation << 1) | (pass ? 1 : 0);
+    return pass;
+}
+
 //-----------------------------------------------------------------------------
-// [SECTION] ImGuiTextBuffer
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
 //-----------------------------------------------------------------------------
 
 // On some platform vsnprintf() takes va_list by reference and modifies it.
@@ -2194,6 +2441,21 @@ void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
     va_end(args_copy);
 }
 
+// Scan [old_size, new_size) for line breaks, 'base' being the beginning of the whole text
+void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
+{
+    IM_ASSERT(old_size >= 0 && new_size >= old_size && old_size == EndOffset);
+    if (old_size == new_size)
+        return;
+    if (EndOffset == 0 || base[EndOffset - 1] == '\n')
+        LineOffsets.push_back(EndOffset);
+    const char* base_end = base + new_size;
+    for (const char* p = base + old_size; (p = (const char*)memchr(p, '\n', (size_t)(base_end - p))) != NULL; )
+        if (++p < base_end) // Don't start a line after a trailing \n: it will be started by the next append()
+            LineOffsets.push_back((int)(p - base));
+    EndOffset = new_size;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 // This is currently not as flexible/powerful as it should be and really confusing/spaghetti, mostly because we changed
@@ -2208,6 +2470,18 @@ static bool GetSkipItemForListClipping()
     return (g.CurrentTable ? g.CurrentTable->HostSkipItems : g.CurrentWindow->SkipItems);
 }
 
+// We create the union of the ClipRect and the NavScoringRect which at worst should be 1 page away from ClipRect
+static ImRect GetListClippingRect(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    ImRect unclipped_rect = window->ClipRect;
+    if (g.NavMoveRequest)
+        unclipped_rect.Add(g.NavScoringRect);
+    if (g.NavJustMovedToId && window->NavLastIds[0] == g.NavJustMovedToId)
+        unclipped_rect.Add(ImRect(window->Pos + window->NavRectRel[0].Min, window->Pos + window->NavRectRel[0].Max));
+    return unclipped_rect;
+}
+
 // Helper to calculate coarse clipping of large list of evenly sized items.
 // NB: Prefer using the ImGuiListClipper higher-level helper if you can! Read comments and instructions there on how those use this sort of pattern.
 // NB: 'items_count' is only used to clamp the result, if you don't know your count you can use INT_MAX
@@ -2228,13 +2502,7 @@ void ImGui::CalcListClipping(int items_count, float items_height, int* out_items
         return;
     }
 
-    // We create the union of the ClipRect and the NavScoringRect which at worst should be 1 page away from ClipRect
-    ImRect unclipped_rect = window->ClipRect;
-    if (g.NavMoveRequest)
-        unclipped_rect.Add(g.NavScoringRect);
-    if (g.NavJustMovedToId && window->NavLastIds[0] == g.NavJustMovedToId)
-        unclipped_rect.Add(ImRect(window->Pos + window->NavRectRel[0].Min, window->Pos + window->NavRectRel[0].Max));
-
+    const ImRect unclipped_rect = GetListClippingRect(window);
     const ImVec2 pos = window->DC.CursorPos;
     int start = (int)((unclipped_rect.Min.y - pos.y) / items_height);
     int end = (int)((unclipped_rect.Max.y - pos.y) / items_height);
@@ -2276,6 +2544,80 @@ static void SetCursorPosYAndSetupForPrevLine(float pos_y, float line_height)
     }
 }
 
+// ImGuiListClipper::Step() for items of different heights (after frozen rows and StartPosY are handled by Step())
+// - Step 0: find the first visible item from its offset, and seek the cursor to it.
+// - Step 1: measure the item just submitted, then return the next item, until the cursor goes past the clipping rectangle.
+static bool ListClipperStepWithHeights(ImGuiListClipper* clipper)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiTable* table = g.CurrentTable;
+    ImGuiListClipperHeights* heights = clipper->Heights;
+    const int items_count = clipper->ItemsCount;
+    const int items_frozen = clipper->ItemsFrozen;
+
+    int item_idx;
+    if (clipper->StepNo == 0)
+    {
+        const float base_offset = heights->GetItemOffset(items_frozen);
+        if (g.LogEnabled)
+        {
+            // If logging is active, do not perform any clipping
+            item_idx = items_frozen;
+            clipper->ClipMaxPosY = FLT_MAX;
+            clipper->ExtraItems = 0;
+        }
+        else
+        {
+            const ImRect unclipped_rect = GetListClippingRect(window);
+            item_idx = ImMax(heights->FindItemAtOffset(base_offset + unclipped_rect.Min.y - clipper->StartPosY), items_frozen);
+
+            // When performing a navigation request, ensure we have one item extra in the direction we are moving to
+            if (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Up && item_idx > items_frozen)
+                item_idx--;
+            clipper->ClipMaxPosY = unclipped_rect.Max.y;
+            clipper->ExtraItems = (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Down) ? 1 : 0;
+        }
+        clipper->DisplayStart = clipper->DisplayEnd = item_idx;
+
+        // Seek cursor
+        if (item_idx > items_frozen)
+            SetCursorPosYAndSetupForPrevLine(clipper->StartPosY + heights->GetItemOffset(item_idx) - base_offset, heights->DefaultHeight);
+        clipper->StepNo = 1;
+    }
+    else
+    {
+        // Measure the item we just submitted
+        float item_end_y = window->DC.CursorPos.y;
+        if (table)
+            item_end_y = window->DC.CursorPos.y = table->RowPosY2;  // Take account of tallest cell
+        const int prev_idx = clipper->DisplayStart;
+        const float item_height = item_end_y - clipper->ItemPosY;
+        if (heights->Heights[prev_idx] != item_height)
+            heights->SetItemHeight(prev_idx, item_height);
+
+        item_idx = prev_idx + 1;
+        if (item_end_y >= clipper->ClipMaxPosY && item_idx < items_count)
+        {
+            if (clipper->ExtraItems == 0)
+                item_idx = items_count;
+            else
+                clipper->ExtraItems--;
+        }
+    }
+
+    // Reached end of list or of visible area
+    if (item_idx >= items_count)
+    {
+        clipper->End();
+        return false;
+    }
+    clipper->DisplayStart = item_idx;
+    clipper->DisplayEnd = item_idx + 1;
+    clipper->ItemPosY = window->DC.CursorPos.y;
+    return true;
+}
+
 ImGuiListClipper::ImGuiListClipper()
 {
     memset(this, 0, sizeof(*this));
@@ -2306,6 +2648,17 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     StepNo = 0;
     DisplayStart = -1;
     DisplayEnd = 0;
+    Heights = NULL;
+}
+
+void ImGuiListClipper::Begin(int items_count, ImGuiListClipperHeights* heights)
+{
+    IM_ASSERT(heights != NULL && items_count >= 0 && items_count < INT_MAX);
+    Begin(items_count, -1.0f);
+    Heights = heights;
+    if (heights->DefaultHeight <= 0.0f)
+        heights->DefaultHeight = ImGui::GetTextLineHeightWithSpacing();
+    heights->Resize(items_count);
 }
 
 void ImGuiListClipper::End()
@@ -2314,7 +2667,9 @@ void ImGuiListClipper::End()
         return;
 
     // In theory here we should assert that ImGui::GetCursorPosY() == StartPosY + DisplayEnd * ItemsHeight, but it feels saner to just seek at the end and not assert/crash the user.
-    if (ItemsCount < INT_MAX && DisplayStart >= 0)
+    if (Heights != NULL && DisplayStart >= 0)
+        SetCursorPosYAndSetupForPrevLine(StartPosY + Heights->GetTotalHeight() - Heights->GetItemOffset(ItemsFrozen), Heights->DefaultHeight);
+    else if (ItemsCount < INT_MAX && DisplayStart >= 0)
         SetCursorPosYAndSetupForPrevLine(StartPosY + (ItemsCount - ItemsFrozen) * ItemsHeight, ItemsHeight);
     ItemsCount = -1;
     StepNo = 3;
@@ -2350,6 +2705,8 @@ bool ImGuiListClipper::Step()
         }
 
         StartPosY = window->DC.CursorPos.y;
+        if (Heights != NULL)
+            return ListClipperStepWithHeights(this);
         if (ItemsHeight <= 0.0f)
         {
             // Submit the first item so we can measure its height (generally it is 0..1)
@@ -2364,6 +2721,9 @@ bool ImGuiListClipper::Step()
         StepNo = 2;
     }
 
+    if (Heights != NULL)
+        return ListClipperStepWithHeights(this);
+
     // Step 1: the clipper infer height from first element
     if (StepNo == 1)
     {
@@ -2423,6 +2783,63 @@ bool ImGuiListClipper::Step()
     return false;
 }
 
+void ImGuiListClipperHeights::Resize(int items_count)
+{
+    IM_ASSERT(items_count >= 0);
+    const int old_count = Heights.Size;
+    if (items_count == old_count)
+        return;
+    Heights.resize(items_count);
+    Tree.resize(items_count + 1);
+    Tree[0] = 0.0;
+
+    // Tree nodes of existing items only cover items before them, so they remain valid. New node i covers the items (i - lowbit(i), i].
+    for (int i = old_count + 1; i <= items_count; i++)
+    {
+        Heights[i - 1] = DefaultHeight;
+        double sum = DefaultHeight;
+        for (int j = i - 1, j_min = i - (i & -i); j > j_min; j -= (j & -j))
+            sum += Tree[j];
+        Tree[i] = sum;
+    }
+}
+
+void ImGuiListClipperHeights::SetItemHeight(int item_idx, float height)
+{
+    IM_ASSERT(item_idx >= 0 && item_idx < Heights.Size);
+    const double delta = (double)height - Heights[item_idx];
+    Heights[item_idx] = height;
+    for (int i = item_idx + 1; i < Tree.Size; i += (i & -i))
+        Tree[i] += delta;
+}
+
+float ImGuiListClipperHeights::GetItemOffset(int item_idx) const
+{
+    IM_ASSERT(item_idx >= 0 && item_idx <= Heights.Size);
+    double sum = 0.0;
+    for (int i = item_idx; i > 0; i -= (i & -i))
+        sum += Tree[i];
+    return (float)sum;
+}
+
+int ImGuiListClipperHeights::FindItemAtOffset(float offset) const
+{
+    // Descend the tree, accumulating the heights of the items entirely before 'offset'
+    const int items_count = Heights.Size;
+    int step = 1;
+    while (step * 2 <= items_count)
+        step *= 2;
+    int pos = 0;
+    double remaining = offset;
+    for (; step > 0; step >>= 1)
+        if (pos + step <= items_count && Tree[pos + step] <= remaining)
+        {
+            pos += step;
+            remaining -= Tree[pos];
+        }
+    return pos;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] STYLING
 //-----------------------------------------------------------------------------
@@ -2705,7 +3122,19 @@ void ImGui::RenderTextWrapped(ImVec2 pos, const char* text, const char* text_end
 
     if (text != text_end)
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+        const ImGuiTextLayoutCacheEntry* layout = (g.IO.ConfigTextLayoutCache && wrap_width > 0.0f) ? GetTextLayout(g.Font, g.FontSize, wrap_width, text, text_end) : NULL;
+        if (layout)
+        {
+            // Same as ImDrawList::AddText(), passing the word-wrap positions measured by CalcTextSize()
+            ImDrawList* draw_list = window->DrawList;
+            const ImU32 col = GetColorU32(ImGuiCol_Text);
+            if (col & IM_COL32_A_MASK)
+                g.Font->RenderText(draw_list, g.FontSize, pos, col, draw_list->_CmdHeader.ClipRect, text, text_end, wrap_width, false, g.TextLayoutCache.WrapEols.Data + layout->WrapEolsOffset, layout->WrapEolsCount);
+        }
+        else
+        {
+            window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+        }
         if (g.LogEnabled)
             LogRenderedText(&pos, text, text_end);
     }
@@ -2918,6 +3347,7 @@ ImGuiWindow::ImGuiWindow(ImGuiContext* context, const char* name) : DrawListInst
     LastTimeActive = -1.0f;
     FontWindowScale = 1.0f;
     SettingsOffset = -1;
+    DrawListCacheRecordCmd = -1;
     DrawList = &DrawListInst;
     DrawList->_Data = &context->DrawListSharedData;
     DrawList->_OwnerName = Name;
@@ -3037,7 +3467,10 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->MemoryDrawListVtxCapacity = window->DrawList->VtxBuffer.Capacity;
     window->IDStack.clear();
     window->DrawList->_ClearFreeMemory();
+    window->DrawListCache.ClearFreeMemory();
+    window->DrawListCacheSignature = 0;
     window->DC.ChildWindows.clear();
+    window->DC.DeferredDrawLists.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
 }
@@ -3327,11 +3760,23 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
     return ImMax(wrap_pos_x - pos.x, 1.0f);
 }
 
+// Deferred draw lists (see AddDeferredDrawList()) grow their buffers from user threads, so the allocation counter is updated atomically.
+static void UpdateActiveAllocationsCounter(int* counter, int delta)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    _InterlockedExchangeAdd((volatile long*)counter, (long)delta);
+#elif defined(__GNUC__) || defined(__clang__)
+    __atomic_fetch_add(counter, delta, __ATOMIC_RELAXED);
+#else
+    *counter += delta;
+#endif
+}
+
 // IM_ALLOC() == ImGui::MemAlloc()
 void* ImGui::MemAlloc(size_t size)
 {
     if (ImGuiContext* ctx = GImGui)
-        ctx->IO.MetricsActiveAllocations++;
+        UpdateActiveAllocationsCounter(&ctx->IO.MetricsActiveAllocations, +1);
     return (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 }
 
@@ -3340,7 +3785,7 @@ void ImGui::MemFree(void* ptr)
 {
     if (ptr)
         if (ImGuiContext* ctx = GImGui)
-            ctx->IO.MetricsActiveAllocations--;
+            UpdateActiveAllocationsCounter(&ctx->IO.MetricsActiveAllocations, -1);
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
 
@@ -3939,7 +4384,10 @@ void ImGui::NewFrame()
     UpdateViewportsNewFrame();
 
     // Setup current font and draw list shared data
+    // (rasterize glyphs missed during last frame when using ImFontAtlasFlags_DynamicGlyphs, backend needs to upload the atlas dirty rectangle)
+    g.IO.Fonts->UpdateDynamicGlyphs();
     g.IO.Fonts->Locked = true;
+    g.TextLayoutCache.NewFrame(g.IO.Fonts, g.FrameCount);
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
     ImRect virtual_space(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
@@ -3957,6 +4405,10 @@ void ImGui::NewFrame()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.ConfigDrawListShapeCache)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_ShapeCache;
+    g.DrawListShapeCache.NewFrame();
+    g.DeferredDrawListsSharedDataUsed = 0;
 
     // Mark rendering data as invalid to prevent user who may have a handle on it to use it.
     for (int n = 0; n < g.Viewports.Size; n++)
@@ -4206,6 +4658,9 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.BeginPopupStack.clear();
 
     g.Viewports.clear_delete();
+    g.DrawListShapeCache.Clear();
+    g.DeferredDrawListsSharedData.clear_delete();
+    g.TextLayoutCache.Clear();
 
     g.TabBars.Clear();
     g.CurrentTabBarStack.clear();
@@ -4306,6 +4761,8 @@ static void AddWindowToDrawData(ImGuiWindow* window, int layer)
     ImGuiViewportP* viewport = g.Viewports[0];
     g.IO.MetricsRenderWindows++;
     AddDrawListToDrawData(&viewport->DrawDataBuilder.Layers[layer], window->DrawList);
+    for (int i = 0; i < window->DC.DeferredDrawLists.Size; i++)
+        AddDrawListToDrawData(&viewport->DrawDataBuilder.Layers[layer], window->DC.DeferredDrawLists[i]);
     for (int i = 0; i < window->DC.ChildWindows.Size; i++)
     {
         ImGuiWindow* child = window->DC.ChildWindows[i];
@@ -4523,6 +4980,108 @@ void ImGui::Render()
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
 }
 
+void ImGuiTextLayoutCache::NewFrame(const ImFontAtlas* atlas, int frame_count)
+{
+    HitsLastFrame = Hits;
+    MissesLastFrame = Misses;
+    Hits = Misses = 0;
+    if (Atlas != atlas || AtlasBuildGeneration != atlas->BuildGeneration)
+    {
+        Clear();
+        Atlas = atlas;
+        AtlasBuildGeneration = atlas->BuildGeneration;
+        return;
+    }
+
+    // Evict entries unused for IMGUI_TEXT_LAYOUT_CACHE_MAX_AGE frames. Buffers are filled in the same order as Entries[], so they are compacted in place.
+    const int min_frame_used = frame_count - IMGUI_TEXT_LAYOUT_CACHE_MAX_AGE;
+    int alive_count = 0;
+    for (int n = 0; n < Entries.Size; n++)
+        if (Entries.Data[n].LastFrameUsed >= min_frame_used)
+            alive_count++;
+    if (alive_count == Entries.Size)
+        return;
+
+    Map.Clear();
+    int text_size = 0, wrap_eols_size = 0, entries_size = 0;
+    for (int n = 0; n < Entries.Size; n++)
+    {
+        ImGuiTextLayoutCacheEntry entry = Entries.Data[n];
+        if (entry.LastFrameUsed < min_frame_used)
+            continue;
+        memmove(TextBuffer.Data + text_size, TextBuffer.Data + entry.TextOffset, (size_t)entry.TextLen);
+        memmove(WrapEols.Data + wrap_eols_size, WrapEols.Data + entry.WrapEolsOffset, (size_t)entry.WrapEolsCount * sizeof(int));
+        entry.TextOffset = text_size;
+        entry.WrapEolsOffset = wrap_eols_size;
+        text_size += entry.TextLen;
+        wrap_eols_size += entry.WrapEolsCount;
+        Map.SetInt(entry.KeyHash, entries_size + 1);
+        Entries.Data[entries_size++] = entry;
+    }
+    Entries.resize(entries_size);
+    TextBuffer.resize(text_size);
+    WrapEols.resize(wrap_eols_size);
+}
+
+ImGuiTextLayoutCacheEntry* ImGuiTextLayoutCache::Find(ImGuiID key_hash, ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    const int entry_idx = Map.GetInt(key_hash, 0) - 1;
+    if (entry_idx < 0)
+        return NULL;
+    ImGuiTextLayoutCacheEntry* entry = &Entries.Data[entry_idx];
+    const int text_len = (int)(text_end - text);
+    if (entry->Font != font || entry->FontSize != font_size || entry->WrapWidth != wrap_width || entry->TextLen != text_len || memcmp(TextBuffer.Data + entry->TextOffset, text, (size_t)text_len) != 0)
+        return NULL;
+    return entry;
+}
+
+// Measure text and store its layout
+ImGuiTextLayoutCacheEntry* ImGuiTextLayoutCache::Add(ImGuiID key_hash, ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    ImGuiTextLayoutCacheEntry entry;
+    entry.KeyHash = key_hash;
+    entry.Font = font;
+    entry.FontSize = font_size;
+    entry.WrapWidth = wrap_width;
+    entry.TextOffset = TextBuffer.Size;
+    entry.TextLen = (int)(text_end - text);
+    entry.WrapEolsOffset = WrapEols.Size;
+    entry.Size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_end, NULL, (wrap_width > 0.0f) ? &WrapEols : NULL);
+    entry.WrapEolsCount = WrapEols.Size - entry.WrapEolsOffset;
+    entry.LastFrameUsed = -1;
+    TextBuffer.resize(TextBuffer.Size + entry.TextLen);
+    memcpy(TextBuffer.Data + entry.TextOffset, text, (size_t)entry.TextLen);
+    Map.SetInt(key_hash, Entries.Size + 1);
+    Entries.push_back(entry);
+    return &Entries.back();
+}
+
+// Return the layout of a text from the text layout cache, measuring it on a miss. Return NULL for fonts of another atlas (we can't tell when they are rebuilt).
+static const ImGuiTextLayoutCacheEntry* GetTextLayout(ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTextLayoutCache& cache = g.TextLayoutCache;
+    if (font->ContainerAtlas != cache.Atlas)
+        return NULL;
+
+    ImGuiID key_hash = ImHashData(&font, sizeof(font), 0);
+    key_hash = ImHashData(&font_size, sizeof(font_size), key_hash);
+    key_hash = ImHashData(&wrap_width, sizeof(wrap_width), key_hash);
+    key_hash = ImHashData(text, (size_t)(text_end - text), key_hash);
+    ImGuiTextLayoutCacheEntry* entry = cache.Find(key_hash, font, font_size, wrap_width, text, text_end);
+    if (entry)
+    {
+        cache.Hits++;
+    }
+    else
+    {
+        entry = cache.Add(key_hash, font, font_size, wrap_width, text, text_end);
+        cache.Misses++;
+    }
+    entry->LastFrameUsed = g.FrameCount;
+    return entry;
+}
+
 // Calculate text size. Text can be multi-line. Optionally ignore text after a ## marker.
 // CalcTextSize("") should return ImVec2(0.0f, g.FontSize)
 ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_text_after_double_hash, float wrap_width)
@@ -4539,7 +5098,8 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    const ImGuiTextLayoutCacheEntry* layout = (g.IO.ConfigTextLayoutCache && wrap_width > 0.0f) ? GetTextLayout(font, font_size, wrap_width, text, text_display_end ? text_display_end : text + strlen(text)) : NULL;
+    ImVec2 text_size = layout ? layout->Size : font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
     // FIXME: This has been here since Dec 2015 (7b0bf230) but down the line we want this out.
@@ -5143,6 +5703,7 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
     // Create window the first time
     ImGuiWindow* window = IM_NEW(ImGuiWindow)(&g, name);
     window->Flags = flags;
+    window->StateStorage.SetUseHashIndex(g.IO.ConfigWindowsStorageUseHashIndex);
     g.WindowsById.SetVoidPtr(window->ID, window);
 
     // Default/arbitrary window position. Use SetNextWindowPos() with the appropriate condition flag to change the initial position of a window.
@@ -5229,6 +5790,8 @@ static void CalcWindowContentSizes(ImGuiWindow* window, ImVec2* content_size_cur
         preserve_old_content_sizes = true;
     else if (window->Hidden && window->HiddenFramesCannotSkipItems == 0 && window->HiddenFramesCanSkipItems > 0)
         preserve_old_content_sizes = true;
+    else if (window->DrawListCacheReplayed)
+        preserve_old_content_sizes = true;
     if (preserve_old_content_sizes)
     {
         *content_size_current = window->ContentSize;
@@ -5730,12 +6293,75 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
     }
 }
 
+// Contents of a window using ImGuiWindowFlags_CachedDrawList may be replayed when the user cannot be interacting with it.
+static bool IsWindowDrawListCacheable(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->Appearing || window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0)
+        return false;
+    if (g.HoveredWindow == window || g.ActiveIdWindow == window || g.ActiveIdPreviousFrameWindow == window)
+        return false;
+    if (g.NavWindow == window && !g.NavDisableHighlight)
+        return false;
+    if (g.DragDropActive || g.LogEnabled)
+        return false;
+    for (int n = 0; n < g.OpenPopupStack.Size; n++)
+        if (g.OpenPopupStack[n].Window == NULL || g.OpenPopupStack[n].Window->ParentWindow == window)
+            return false;
+    return true;
+}
+
+// Hash everything which may affect the output of a window contents without the user code knowing about it.
+static ImGuiID CalcWindowDrawListCacheSignature(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    const ImDrawListSharedData* shared_data = window->DrawList->_Data;
+    const float state_f[] =
+    {
+        window->Pos.x, window->Pos.y, window->Size.x, window->Size.y, window->Scroll.x, window->Scroll.y,
+        window->ClipRect.Min.x, window->ClipRect.Min.y, window->ClipRect.Max.x, window->ClipRect.Max.y,
+        window->FontWindowScale, g.FontSize, shared_data->TexUvWhitePixel.x, shared_data->TexUvWhitePixel.y
+    };
+    const int state_i[] = { (int)window->Flags, (int)window->DrawList->Flags, (int)g.CurrentItemFlags };
+    const void* state_p[] = { g.Font, g.IO.Fonts->TexID };
+    ImGuiID seed = ImHashData(&g.Style, sizeof(g.Style));
+    seed = ImHashData(state_f, sizeof(state_f), seed);
+    seed = ImHashData(state_i, sizeof(state_i), seed);
+    seed = ImHashData(state_p, sizeof(state_p), seed);
+    return seed ? seed : 1;
+}
+
+// Return true when the window contents were replayed from its cache, in which case items don't need to be submitted.
+// Otherwise start recording them, they will be stored in End().
+static bool UpdateWindowDrawListCache(ImGuiWindow* window)
+{
+    if (!IsWindowDrawListCacheable(window))
+    {
+        ImGui::MarkWindowDrawListDirty(window);
+        return false;
+    }
+
+    ImDrawList* draw_list = window->DrawList;
+    const ImGuiID signature = CalcWindowDrawListCacheSignature(window);
+    if (signature == window->DrawListCacheSignature && window->DrawListCache.Replay(draw_list))
+    {
+        window->DrawListCacheReplayed = true;
+        return true;
+    }
+    window->DrawListCacheSignature = signature;
+    window->DrawListCacheRecordCmd = draw_list->CmdBuffer.Size - 1;
+    window->DrawListCacheRecordIdx = draw_list->IdxBuffer.Size;
+    window->DrawListCacheRecordVtx = draw_list->VtxBuffer.Size;
+    return false;
+}
+
 // Push a new Dear ImGui window to add widgets to.
 // - A default window called "Debug" is automatically stacked at the beginning of every frame so you can use widgets without explicitly calling a Begin/End pair.
 // - Begin/End can be called multiple times during the frame with the same window name to append content.
 // - The window name is used as a unique identifier to preserve window information across frames (and save rudimentary information to the .ini file).
 //   You can use the "##" or "###" markers to use the same label with different id, or same id with different label. See documentation at the top of this file.
 // - Return false when window is collapsed, so you can early out in your code. You always need to call ImGui::End() even if false is returned.
+//   With ImGuiWindowFlags_CachedDrawList, also return false when the window contents were replayed from a previous frame.
 // - Passing 'bool* p_open' displays a Close button on the upper-right corner of the window, the pointed value will be set to false when the button is pressed.
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
@@ -5899,6 +6525,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         // Update contents size from last frame for auto-fitting (or use explicit size)
         const bool window_just_appearing_after_hidden_for_resize = (window->HiddenFramesCannotSkipItems > 0);
         CalcWindowContentSizes(window, &window->ContentSize, &window->ContentSizeIdeal);
+        window->DrawListCacheReplayed = false;
         if (window->HiddenFramesCanSkipItems > 0)
             window->HiddenFramesCanSkipItems--;
         if (window->HiddenFramesCannotSkipItems > 0)
@@ -6270,6 +6897,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->DC.TreeDepth = 0;
         window->DC.TreeJumpToParentOnPopMask = 0x00;
         window->DC.ChildWindows.resize(0);
+        window->DC.DeferredDrawLists.resize(0);
         window->DC.StateStorage = &window->StateStorage;
         window->DC.CurrentColumns = NULL;
         window->DC.LayoutType = ImGuiLayoutType_Vertical;
@@ -6322,7 +6950,10 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     else
     {
         // Append
+        // (contents submitted over multiple Begin/End pairs are not cached)
         SetCurrentWindow(window);
+        if (window->DrawListCacheSignature != 0)
+            MarkWindowDrawListDirty(window);
     }
 
     // Pull/inherit current state
@@ -6375,6 +7006,11 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         if (window->Collapsed || !window->Active || window->Hidden)
             if (window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0 && window->HiddenFramesCannotSkipItems <= 0)
                 skip_items = true;
+
+        // Replay contents recorded on a previous frame, or record them for next frame
+        window->DrawListCacheRecordCmd = -1;
+        if ((flags & ImGuiWindowFlags_CachedDrawList) && !skip_items)
+            skip_items = UpdateWindowDrawListCache(window);
         window->SkipItems = skip_items;
     }
 
@@ -6401,6 +7037,14 @@ void ImGui::End()
     // Close anything that is open
     if (window->DC.CurrentColumns)
         EndColumns();
+
+    // Store contents recorded for ImGuiWindowFlags_CachedDrawList (child windows and deferred draw lists are not part of our draw list, so we can't cache a window submitting them)
+    if (window->DrawListCacheRecordCmd != -1)
+    {
+        if (window->DC.ChildWindows.Size > 0 || window->DC.DeferredDrawLists.Size > 0 || !window->DrawListCache.Capture(window->DrawList, window->DrawListCacheRecordCmd, window->DrawListCacheRecordIdx, window->DrawListCacheRecordVtx))
+            MarkWindowDrawListDirty(window);
+        window->DrawListCacheRecordCmd = -1;
+    }
     PopClipRect();   // Inner window clip rectangle
 
     // Stop logging
@@ -6897,6 +7541,19 @@ void ImGui::SetWindowFocus(const char* name)
     }
 }
 
+void ImGui::MarkWindowDrawListDirty(const char* name)
+{
+    if (ImGuiWindow* window = FindWindowByName(name))
+        MarkWindowDrawListDirty(window);
+}
+
+// Discard contents recorded for ImGuiWindowFlags_CachedDrawList. When called while the window is being submitted, the current frame is not recorded either.
+void ImGui::MarkWindowDrawListDirty(ImGuiWindow* window)
+{
+    window->DrawListCacheSignature = 0;
+    window->DrawListCacheRecordCmd = -1;
+}
+
 void ImGui::SetNextWindowPos(const ImVec2& pos, ImGuiCond cond, const ImVec2& pivot)
 {
     ImGuiContext& g = *GImGui;
@@ -6969,6 +7626,32 @@ ImDrawList* ImGui::GetWindowDrawList()
     return window->DrawList;
 }
 
+// Deferred draw lists let the user build contents of independent windows or child regions on worker threads.
+// - Setup is done here on the main thread: the draw list is reset, and we push the current window clip rectangle and font texture.
+// - The draw list gets its own copy of ImDrawListSharedData, taken now: the main thread keeps writing to g.DrawListSharedData (current font and size, etc.)
+//   while the draw list is being filled. The copy doesn't use the tessellation cache (ImDrawListFlags_ShapeCache), which isn't thread-safe.
+// - Deferred draw lists are output after the window DrawList and before its child windows, in call order, so the result is deterministic.
+bool ImGui::AddDeferredDrawList(ImDrawList* draw_list)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = GetCurrentWindow();
+    if (g.DeferredDrawListsSharedDataUsed == g.DeferredDrawListsSharedData.Size)
+        g.DeferredDrawListsSharedData.push_back(IM_NEW(ImDrawListSharedData)());
+    ImDrawListSharedData* shared_data = g.DeferredDrawListsSharedData[g.DeferredDrawListsSharedDataUsed++];
+    *shared_data = g.DrawListSharedData;
+    shared_data->ShapeCache = NULL;
+    draw_list->_Data = shared_data;
+    draw_list->_ResetForNewFrame();
+    draw_list->Flags &= ~ImDrawListFlags_ShapeCache;
+    draw_list->PushTextureID(g.Font->ContainerAtlas->TexID);
+    draw_list->PushClipRect(window->ClipRect.Min, window->ClipRect.Max);
+    if (window->SkipItems)
+        return false;
+    IM_ASSERT(!window->DC.DeferredDrawLists.contains(draw_list));
+    window->DC.DeferredDrawLists.push_back(draw_list);
+    return true;
+}
+
 ImFont* ImGui::GetFont()
 {
     return GImGui->Font;
@@ -11254,6 +11937,20 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         Text("NavWindowingTarget: '%s'", g.NavWindowingTarget ? g.NavWindowingTarget->Name : "NULL");
         Unindent();
 
+        Text("DRAWING");
+        Indent();
+        {
+            const ImDrawListShapeCache& shape_cache = g.DrawListShapeCache;
+            const int shape_lookups = shape_cache.HitsLastFrame + shape_cache.MissesLastFrame;
+            Text("ShapeCache: %s, %d entries, %d vertices", io.ConfigDrawListShapeCache ? "enabled" : "disabled", shape_cache.Entries.Size, shape_cache.VtxBuffer.Size);
+            Text("ShapeCache: %d hits, %d misses (%.1f%% hit rate)", shape_cache.HitsLastFrame, shape_cache.MissesLastFrame, shape_lookups > 0 ? shape_cache.HitsLastFrame * 100.0f / shape_lookups : 0.0f);
+            const ImGuiTextLayoutCache& text_layout_cache = g.TextLayoutCache;
+            const int text_layout_lookups = text_layout_cache.HitsLastFrame + text_layout_cache.MissesLastFrame;
+            Text("TextLayoutCache: %s, %d entries, %d bytes of text, %d line breaks", io.ConfigTextLayoutCache ? "enabled" : "disabled", text_layout_cache.Entries.Size, text_layout_cache.TextBuffer.Size, text_layout_cache.WrapEols.Size);
+            Text("TextLayoutCache: %d hits, %d misses (%.1f%% hit rate)", text_layout_cache.HitsLastFrame, text_layout_cache.MissesLastFrame, text_layout_lookups > 0 ? text_layout_cache.HitsLastFrame * 100.0f / text_layout_lookups : 0.0f);
+        }
+        Unindent();
+
         TreePop();
     }
 
@@ -11336,6 +12033,8 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
         Image(atlas->TexID, ImVec2((float)atlas->TexWidth, (float)atlas->TexHeight), ImVec2(0.0f, 0.0f), ImVec2(1.0f, 1.0f), tint_col, border_col);
         TreePop();
     }
+    if (ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs)
+        BulletText("Dynamic glyphs: %d in texture (%d shelves in rows %d..%d), %d rasterized, %d evicted, %d queued", dyn->Glyphs.Size, dyn->Shelves.Size, dyn->AreaY0, dyn->AreaY1, dyn->RasterizedCount, dyn->EvictedCount, dyn->Requests.Size);
 }
 
 // [DEBUG] Display contents of Columns
@@ -11676,6 +12375,8 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
     BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
     BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
     BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems);
+    if (flags & ImGuiWindowFlags_CachedDrawList)
+        BulletText("DrawListCache: %d cmds, %d idx, %d vtx, Valid: %d, Replayed: %d", window->DrawListCache.CmdBuffer.Size, window->DrawListCache.IdxBuffer.Size, window->DrawListCache.VtxBuffer.Size, window->DrawListCacheSignature != 0, window->DrawListCacheReplayed);
     for (int layer = 0; layer < ImGuiNavLayer_COUNT; layer++)
     {
         ImRect r = window->NavRectRel[layer];
@@ -28,7 +28,7 @@ Index of this file:
 // [SECTION] ImGuiStyle
 // [SECTION] ImGuiIO
 // [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload, ImGuiTableSortSpecs, ImGuiTableColumnSortSpecs)
-// [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
+// [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextFilterCache, ImGuiTextBuffer, ImGuiTextIndex, ImGuiStorage, ImGuiListClipper, ImGuiListClipperHeights, ImGuiTreeView, ImGuiTableDataSource, ImColor)
 // [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
@@ -140,6 +140,7 @@ struct ImDrawListSplitter;          // Helper to split a draw list into differen
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontAtlasDynamicGlyphs;    // Opaque storage for glyphs rasterized on demand (see ImFontAtlasFlags_DynamicGlyphs)
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
@@ -149,6 +150,8 @@ struct ImGuiContext;                // Dear ImGui context (opaque structure, unl
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListClipperHeights;     // Helper to hold the heights of a list of items of different heights, for ImGuiListClipper
+struct ImGuiTreeView;               // Helper to display a very large tree by only submitting its visible rows, with TreeViewNode()
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame, used by IMGUI_ONCE_UPON_A_FRAME macro
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiSizeCallbackData;       // Callback data when using SetNextWindowSizeConstraints() (rare/advanced use)
@@ -156,8 +159,11 @@ struct ImGuiStorage;                // Helper for key->value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often handling sort specs for a single column, occasionally more)
 struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a table
+struct ImGuiTableDataSource;        // Helper to display and sort a very large table from callbacks, with TableDataSourceRows()
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
+struct ImGuiTextFilterCache;        // Helper to cache ImGuiTextFilter results for a large list of items
+struct ImGuiTextIndex;              // Helper to hold an incrementally built index of line offsets into a text buffer, for TextUnformattedIndexed()
 struct ImGuiViewport;               // A Platform Window (always only one in 'master' branch), in the future may represent Platform Monitor
 
 // Enums/Flags (declared as int for compatibility with old C++, to allow using as flags and to not pollute the top of this file)
@@ -209,6 +215,10 @@ typedef int (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData* data);    // C
 typedef void (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);             // Callback function for ImGui::SetNextWindowSizeConstraints()
 typedef void* (*ImGuiMemAllocFunc)(size_t sz, void* user_data);             // Function signature for ImGui::SetAllocatorFunctions()
 typedef void (*ImGuiMemFreeFunc)(void* ptr, void* user_data);               // Function signature for ImGui::SetAllocatorFunctions()
+typedef void (*ImGuiTaskFunc)(void* task_data, int task_n);                 // Function signature for tasks dispatched by an ImGuiParallelForFunc
+typedef void (*ImGuiParallelForFunc)(void* user_data, int tasks_count, ImGuiTaskFunc task_func, void* task_data); // Function signature for ImFontAtlas::BuildParallelForFn and ImGuiTableDataSource::SortParallelForFn
+typedef void (*ImGuiTableCellFunc)(void* user_data, int row, int column_n);      // Function signature for ImGuiTableDataSource::CellFn
+typedef int (*ImGuiTableRowCompareFunc)(void* user_data, int row_a, int row_b);  // Function signature for ImGuiTableDataSource::SetColumnCompareFn(). Return <0, 0 or >0 like strcmp(), in ascending order.
 
 // Character types
 // (we generally use UTF-8 encoded string in the API. This is storage specifically for a decoded character used for keyboard input and display)
@@ -338,6 +348,7 @@ namespace ImGui
     IMGUI_API bool          IsWindowFocused(ImGuiFocusedFlags flags=0); // is current window focused? or its root/child, depending on flags. see flags for options.
     IMGUI_API bool          IsWindowHovered(ImGuiHoveredFlags flags=0); // is current window hovered (and typically: not blocked by a popup/modal)? see flags for options. NB: If you are trying to check whether your mouse should be dispatched to imgui or to your app, you should use the 'io.WantCaptureMouse' boolean for that! Please read the FAQ!
     IMGUI_API ImDrawList*   GetWindowDrawList();                        // get draw list associated to the current window, to append your own drawing primitives
+    IMGUI_API bool          AddDeferredDrawList(ImDrawList* draw_list); // reset and queue your own draw list to be rendered after the current window contents (in call order). it may then be filled from another thread using ImDrawList functions only, until Render() is called. the draw list gets its own copy of the draw list shared data (current font and size, etc.) so the main thread may keep going. return false if the window is collapsed/clipped and the draw list won't be rendered.
     IMGUI_API ImVec2        GetWindowPos();                             // get current window position in screen space (useful if you want to do your own drawing via the DrawList API)
     IMGUI_API ImVec2        GetWindowSize();                            // get current window size
     IMGUI_API float         GetWindowWidth();                           // get current window width (shortcut for GetWindowSize().x)
@@ -361,6 +372,7 @@ namespace ImGui
     IMGUI_API void          SetWindowSize(const char* name, const ImVec2& size, ImGuiCond cond = 0);    // set named window size. set axis to 0.0f to force an auto-fit on this axis.
     IMGUI_API void          SetWindowCollapsed(const char* name, bool collapsed, ImGuiCond cond = 0);   // set named window collapsed state
     IMGUI_API void          SetWindowFocus(const char* name);                                           // set named window to be focused / top-most. use NULL to remove focus.
+    IMGUI_API void          MarkWindowDrawListDirty(const char* name);                                  // discard contents recorded for a named window using ImGuiWindowFlags_CachedDrawList, so they are submitted again on next Begin().
 
     // Content region
     // - Retrieve available space from a given point. GetContentRegionAvail() is frequently useful.
@@ -468,6 +480,7 @@ namespace ImGui
 
     // Widgets: Text
     IMGUI_API void          TextUnformatted(const char* text, const char* text_end = NULL); // raw text without formatting. Roughly equivalent to Text("%s", text) but: A) doesn't require null terminated string if 'text_end' is specified, B) it's faster, no memory copy is done, no buffer size limits, recommended for long chunks of text.
+    IMGUI_API void          TextUnformattedIndexed(const char* text, ImGuiTextIndex* index);  // raw text using a persistent line index (see ImGuiTextIndex): only visible lines are processed, for huge texts such as logs of hundreds of MB. Honors PushTextWrapPos(). Typically used inside a child window.
     IMGUI_API void          Text(const char* fmt, ...)                                      IM_FMTARGS(1); // formatted text
     IMGUI_API void          TextV(const char* fmt, va_list args)                            IM_FMTLIST(1);
     IMGUI_API void          TextColored(const ImVec4& col, const char* fmt, ...)            IM_FMTARGS(2); // shortcut for PushStyleColor(ImGuiCol_Text, col); Text(fmt, ...); PopStyleColor();
@@ -599,6 +612,7 @@ namespace ImGui
     IMGUI_API bool          CollapsingHeader(const char* label, ImGuiTreeNodeFlags flags = 0);  // if returning 'true' the header is open. doesn't indent nor push on ID stack. user doesn't have to call TreePop().
     IMGUI_API bool          CollapsingHeader(const char* label, bool* p_visible, ImGuiTreeNodeFlags flags = 0); // when 'p_visible != NULL': if '*p_visible==true' display an additional small close button on upper right of the header which will set the bool to false when clicked, if '*p_visible==false' don't display the header.
     IMGUI_API void          SetNextItemOpen(bool is_open, ImGuiCond cond = 0);                  // set next TreeNode/CollapsingHeader open state.
+    IMGUI_API bool          TreeViewNode(ImGuiTreeView* tree, int row, const char* label, ImGuiTreeNodeFlags flags = 0); // tree node for a row of an ImGuiTreeView, between tree->Begin() and tree->Step() returning false. Doesn't push to the ID stack nor indent: don't call TreePop().
 
     // Widgets: Selectables
     // - A selectable highlights when hovered, and can display another color when selected.
@@ -746,6 +760,7 @@ namespace ImGui
     //   wastefully sort your data every frame!
     // - Lifetime: don't hold on this pointer over multiple frames or past any subsequent call to BeginTable().
     IMGUI_API ImGuiTableSortSpecs*  TableGetSortSpecs();                        // get latest sort specs for the table (NULL if not sorting).
+    IMGUI_API void                  TableDataSourceRows(ImGuiTableDataSource* source, float row_min_height = 0.0f); // sort rows of 'source' if needed, then submit the visible ones. See ImGuiTableDataSource.
 
     // Tables: Miscellaneous functions
     // - Functions args 'int column_n' treat the default value of -1 as the same as passing the current column index.
@@ -946,6 +961,7 @@ enum ImGuiWindowFlags_
     ImGuiWindowFlags_NoNavInputs            = 1 << 18,  // No gamepad/keyboard navigation within the window
     ImGuiWindowFlags_NoNavFocus             = 1 << 19,  // No focusing toward this window with gamepad/keyboard navigation (e.g. skipped by CTRL+TAB)
     ImGuiWindowFlags_UnsavedDocument        = 1 << 20,  // Display a dot next to the title. When used in a tab/docking context, tab is selected when clicking the X + closure is not assumed (will wait for user to stop submitting the tab). Otherwise closure is assumed when pressing the X, so if you keep submitting the tab may reappear at end of tab bar.
+    ImGuiWindowFlags_CachedDrawList         = 1 << 21,  // [BETA] Record window contents and replay them on following frames while the window is not interacted with and its position/size/scroll/style don't change. Begin() returns false while replaying. Call MarkWindowDrawListDirty() when displayed data changes. Contents of windows with child windows are never cached.
     ImGuiWindowFlags_NoNav                  = ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
     ImGuiWindowFlags_NoDecoration           = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse,
     ImGuiWindowFlags_NoInputs               = ImGuiWindowFlags_NoMouseInputs | ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
@@ -1824,6 +1840,9 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigDrawListShapeCache;       // = false          // [BETA] Cache tessellation of circles and rectangles, repeated shapes of the same size are emitted by translating the cached vertices. Positions may differ from uncached ones by float rounding.
+    bool        ConfigWindowsStorageUseHashIndex; // = false        // [BETA] Create windows with a hash indexed state storage (see ImGuiStorage::SetUseHashIndex()), for windows holding tens of thousands of tree nodes. Per-window: call GetStateStorage()->SetUseHashIndex() after Begin().
+    bool        ConfigTextLayoutCache;          // = false          // [BETA] Cache the size and word-wrap positions of wrapped text (e.g. TextWrapped()) across frames, keyed by font, size, wrap width and text contents. Rendering reuses the cached line breaks and skips wrapped lines above the clipping rectangle.
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -2017,7 +2036,7 @@ struct ImGuiTableSortSpecs
 };
 
 //-----------------------------------------------------------------------------
-// [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
+// [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextFilterCache, ImGuiTextBuffer, ImGuiTextIndex, ImGuiStorage, ImGuiListClipper, ImGuiListClipperHeights, ImGuiTreeView, ImGuiTableDataSource, ImColor)
 //-----------------------------------------------------------------------------
 
 // Helper: Unicode defines
@@ -2063,6 +2082,28 @@ struct ImGuiTextFilter
     int                     CountGrep;
 };
 
+// Helper: Cache ImGuiTextFilter results for a large list of items (e.g. filtering 100k+ items every frame)
+// - Call Update() every frame before PassFilter(), then PassFilter() only evaluates the filter for items it hasn't seen with the current filter.
+// - Appending characters to the last search term (e.g. "abc" -> "abcd") narrows the filter: items rejected previously are not evaluated again.
+// - Call InvalidateItem() when the text of an item changed, InvalidateAll() when items were inserted, removed or reordered.
+//   Items added at the end of the list are picked up by Update().
+struct ImGuiTextFilterCache
+{
+    IMGUI_API           ImGuiTextFilterCache();
+    IMGUI_API bool      Update(const ImGuiTextFilter* filter, int items_count);      // Return true if the filter changed since the last call
+    IMGUI_API bool      PassFilter(int item_idx, const char* text, const char* text_end = NULL);
+    void                InvalidateItem(int item_idx)    { ItemStates[item_idx] = 0; }
+    void                InvalidateAll()                 { NarrowGeneration = ++Generation; }
+    void                Clear()                         { ItemStates.clear(); FilterText.clear(); InvalidateAll(); }
+
+    // [Internal]
+    const ImGuiTextFilter*  Filter;
+    ImVector<char>          FilterText;         // Copy of Filter->InputBuf when Generation was last incremented
+    ImVector<int>           ItemStates;         // (Generation << 1) | pass, per item. 0: not evaluated.
+    int                     Generation;         // Incremented when the filter changes
+    int                     NarrowGeneration;   // Generations in [NarrowGeneration, Generation] are successive narrowings of the filter
+};
+
 // Helper: Growable text buffer for logging/accumulating text
 // (this could be called 'ImGuiTextBuilder' / 'ImGuiStringBuilder')
 struct ImGuiTextBuffer
@@ -2084,10 +2125,40 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Index of line offsets into a text buffer, for displaying huge texts with TextUnformattedIndexed()
+// - Call append() (or update() for an ImGuiTextBuffer) after appending text: only the newly added text is scanned.
+// - If the text is modified in other ways than appending, call clear() before indexing it again.
+// - The index also caches the layout computed by TextUnformattedIndexed() (line widths, word-wrapped row counts).
+//   Measuring very large texts is spread over several frames, see IMGUI_TEXT_INDEX_LAYOUT_BYTES_PER_FRAME.
+struct ImGuiTextIndex
+{
+    ImVector<int>       LineOffsets;            // Offset of the first character of each line
+    int                 EndOffset;              // Size of the text indexed so far
+
+    // [Internal] Layout cache, maintained by TextUnformattedIndexed() and invalidated when font, font size or wrap width change
+    ImVector<int>       LayoutRowsEnd;          // Cumulative count of visual rows up to and including each measured line (when word-wrapping)
+    int                 LayoutLinesCount;       // Number of lines measured so far
+    float               LayoutMaxWidth;         // Width of the widest line measured so far
+    ImFont*             LayoutFont;
+    float               LayoutFontSize;
+    float               LayoutWrapWidth;
+    int                 LayoutBuildGeneration;  // ImFontAtlas::BuildGeneration of LayoutFont when measured
+
+    ImGuiTextIndex()    { clear(); }
+    void                clear()                 { LineOffsets.clear(); EndOffset = 0; ClearLayout(); }
+    int                 size() const            { return LineOffsets.Size; }
+    const char*         get_line_begin(const char* base, int n) const { return base + LineOffsets[n]; }
+    const char*         get_line_end(const char* base, int n) const   { if (n + 1 < LineOffsets.Size) return base + LineOffsets[n + 1] - 1; return (EndOffset > LineOffsets[n] && base[EndOffset - 1] == '\n') ? base + EndOffset - 1 : base + EndOffset; }
+    IMGUI_API void      append(const char* base, int old_size, int new_size);
+    void                update(const ImGuiTextBuffer& buf)            { if (buf.size() < EndOffset) clear(); append(buf.begin(), EndOffset, buf.size()); }
+    void                ClearLayout()           { LayoutRowsEnd.clear(); LayoutLinesCount = 0; LayoutMaxWidth = 0.0f; LayoutFont = NULL; LayoutFontSize = LayoutWrapWidth = 0.0f; LayoutBuildGeneration = 0; }
+};
+
 // Helper: Key->Value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
 // This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// For storages with many keys or frequent insertions, SetUseHashIndex(true) switches to O(1) average lookup and insertion (see io.ConfigWindowsStorageUseHashIndex)
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -2105,11 +2176,16 @@ struct ImGuiStorage
     };
 
     ImVector<ImGuiStoragePair>      Data;
+    ImVector<int>                   HashIndex;      // When UseHashIndex is set: open addressing table of (index into Data[] + 1), 0 for empty slots. Size is zero or a power of two.
+    bool                            UseHashIndex;   // When set, Data[] is unsorted and queries go through HashIndex[]
+
+    ImGuiStorage()      { UseHashIndex = false; }
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - With UseHashIndex, both are O(1) on average and new pairs are appended to Data[].
+    void                Clear() { Data.clear(); HashIndex.clear(); }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2133,6 +2209,9 @@ struct ImGuiStorage
 
     // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
     IMGUI_API void      BuildSortByKey();
+
+    // Switch between sorted storage and hash index. Contents are preserved. Call BuildSortByKey() if you modified Data[] directly.
+    IMGUI_API void      SetUseHashIndex(bool use_hash_index);
 };
 
 // Helper: Manually clip large list of items.
@@ -2163,6 +2242,10 @@ struct ImGuiListClipper
     int     ItemsFrozen;
     float   ItemsHeight;
     float   StartPosY;
+    ImGuiListClipperHeights* Heights;   // When using Begin(items_count, heights)
+    float   ItemPosY;                   // Position of the item being displayed (when using Heights)
+    float   ClipMaxPosY;                // Stop displaying items past this position (when using Heights)
+    int     ExtraItems;                 // Items to display past ClipMaxPosY for navigation (when using Heights)
 
     IMGUI_API ImGuiListClipper();
     IMGUI_API ~ImGuiListClipper();
@@ -2170,6 +2253,7 @@ struct ImGuiListClipper
     // items_count: Use INT_MAX if you don't know how many items you have (in which case the cursor won't be advanced in the final step)
     // items_height: Use -1.0f to be calculated automatically on first step. Otherwise pass in the distance between your items, typically GetTextLineHeightWithSpacing() or GetFrameHeightWithSpacing().
     IMGUI_API void Begin(int items_count, float items_height = -1.0f);  // Automatically called by constructor if you passed 'items_count' or by Step() in Step 1.
+    IMGUI_API void Begin(int items_count, ImGuiListClipperHeights* heights); // For items of different heights: visible items are returned one at a time and their height is measured and stored in 'heights'.
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
     IMGUI_API bool Step();                                              // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
 
@@ -2178,6 +2262,137 @@ struct ImGuiListClipper
 #endif
 };
 
+// Helper: Persistent heights of a list of items of different heights, for ImGuiListClipper::Begin(items_count, heights)
+// Usage:
+//   static ImGuiListClipperHeights heights;  // Persist across frames
+//   ImGuiListClipper clipper;
+//   clipper.Begin(items_count, &heights);
+//   while (clipper.Step())
+//       for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//           DrawItem(i);                     // Any height, e.g. a tree node which may be expanded
+// - The clipper measures items when it displays them. Items never displayed use DefaultHeight (GetTextLineHeightWithSpacing() if not set).
+// - Heights are indexed by a Fenwick tree (binary indexed tree): finding the item at a scrolling position, the position of an item,
+//   and updating the height of one item all cost O(log N). Adding N items at the end of the list costs O(N log N).
+// - If an item changes height while it isn't displayed, call SetItemHeight(). If items are inserted, removed or reordered, call Clear().
+struct ImGuiListClipperHeights
+{
+    ImVector<float>     Heights;        // Height of each item
+    ImVector<double>    Tree;           // Fenwick tree of Heights, 1-based (Tree[0] is unused). Sums in double so updates don't accumulate rounding errors in large lists.
+    float               DefaultHeight;  // Height of items not measured yet
+
+    ImGuiListClipperHeights(float default_height = 0.0f)    { DefaultHeight = default_height; }
+    void                Clear()                             { Heights.clear(); Tree.clear(); }
+    int                 Size() const                        { return Heights.Size; }
+    float               GetTotalHeight() const              { return GetItemOffset(Heights.Size); }
+    IMGUI_API void      Resize(int items_count);                        // Items added at the end get DefaultHeight
+    IMGUI_API void      SetItemHeight(int item_idx, float height);      // O(log N)
+    IMGUI_API float     GetItemOffset(int item_idx) const;              // Sum of the heights of the items before 'item_idx', O(log N)
+    IMGUI_API int       FindItemAtOffset(float offset) const;           // Index of the item covering 'offset' (Size() if past the end), O(log N)
+};
+
+// Helper: Virtualized tree view, for hierarchies too large to be submitted every frame (e.g. scene graphs with 100k+ nodes)
+// Usage:
+//   static ImGuiTreeView tree;
+//   if (scene_changed)
+//   {
+//       tree.Clear();
+//       AddObjects(&tree, -1, root);       // Call tree.AddNode(parent_idx, object_id) for each object, in depth-first order
+//   }
+//   tree.Begin();
+//   while (tree.Step())
+//       for (int row = tree.DisplayStart; row < tree.DisplayEnd; row++)
+//           ImGui::TreeViewNode(&tree, row, GetObjectName(tree.GetNodeAtRow(row)));
+// - Nodes are stored in depth-first order with the size of their subtree, and the tree view keeps the list of visible nodes
+//   (nodes whose ancestors are all open) with one node per row: only rows within the clipping rectangle are submitted.
+// - Opening or closing a node inserts or removes the rows of its visible descendants, without walking the rest of the tree.
+//   Open states are stored in the window storage, like TreeNode(). Changes made through TreeViewNode() (mouse, keyboard,
+//   SetNextItemOpen()) are applied when Step() returns false. Use SetNodeOpen() to open or close nodes from your code.
+// - Rows all have the same height (measured on the first row).
+// - Keyboard navigation can reach rows which are not submitted (Up/Down/PageUp/PageDown). Left on a closed node moves to its parent.
+struct ImGuiTreeViewNode
+{
+    ImGuiID     Id;             // User identifier (e.g. object id), combined with the ID stack when calling Begin()
+    int         Parent;         // Index of the parent node, -1 for root nodes
+    int         Depth;
+    int         SubtreeSize;    // Number of nodes in this subtree including this node: they are [node_idx, node_idx + SubtreeSize). Updated by AddNode() when the subtree is complete, or by Begin().
+    bool        IsOpen;
+};
+
+struct ImGuiTreeView
+{
+    int                         DisplayStart;       // Rows to submit, updated by Step()
+    int                         DisplayEnd;
+
+    // [Internal]
+    ImVector<ImGuiTreeViewNode> Nodes;              // In depth-first order
+    ImVector<int>               VisibleNodes;       // Node index for each row, in increasing order
+    ImVector<int>               PendingToggles;     // Nodes toggled by TreeViewNode(), applied when Step() returns false
+    ImVector<int>               AddNodeStack;       // Path from a root node to the last added node: nodes whose subtree may still grow
+    ImGuiListClipper            Clipper;
+    ImGuiStorage*               Storage;            // Storage and ID stack where open states were read from
+    ImGuiID                     IdSeed;
+    float                       StartPosX;
+    bool                        VisibleNodesDirty;  // Read open states and rebuild VisibleNodes in Begin()
+
+    IMGUI_API ImGuiTreeView();
+    IMGUI_API void      Clear();
+    IMGUI_API int       AddNode(int parent_idx, ImGuiID id);        // 'parent_idx' must be the last added node or one of its ancestors (or -1). Return the index of the new node.
+    IMGUI_API void      Begin();
+    IMGUI_API bool      Step();                                     // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can call TreeViewNode() for those rows.
+    IMGUI_API void      SetNodeOpen(int node_idx, bool open);       // Open or close a node, updating the visible rows. Requires Begin() to have been called once.
+    IMGUI_API ImGuiID   GetNodeID(int node_idx) const;              // ID submitted by TreeViewNode() for this node. Requires Begin() to have been called once.
+    IMGUI_API int       GetRowOfNode(int node_idx) const;           // -1 if the node is hidden by a closed ancestor, O(log N)
+    int                 GetNodeAtRow(int row) const                 { return VisibleNodes[row]; }
+    int                 GetRowsCount() const                        { return VisibleNodes.Size; }
+};
+
+// Helper: Table data source, for tables with a very large number of rows (e.g. 1M+) which may be sorted
+// Usage:
+//   static ImGuiTableDataSource source;
+//   source.UserData = &my_items;
+//   source.CellFn = MyDrawCell;                       // Submit the contents of one cell, e.g. ImGui::Text("%d", items[row].Id)
+//   source.SetColumnCompareFn(0, MyCompareIds);      // Optional, for each sortable column
+//   source.SetRowsCount(my_items.Size);
+//   if (ImGui::BeginTable("items", 3, ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY))
+//   {
+//       ImGui::TableSetupColumn("ID"); [...]
+//       ImGui::TableHeadersRow();
+//       ImGui::TableDataSourceRows(&source);
+//       ImGui::EndTable();
+//   }
+// - The data source owns a permutation of row indices (SortedRows), sorted again only when the sort specs change.
+//   Only the rows within the clipping rectangle are submitted, with an ImGuiListClipper.
+// - When the values of some rows change, call InvalidateRow() for them: they are removed from the permutation, sorted on
+//   their own and inserted back with binary searches, in O(D log N) compares for D changed rows. Rows added with SetRowsCount() are merged the same way.
+// - The sort is stable: rows comparing equal on every sorted column keep their index order.
+// - Set SortParallelForFn to sort on your own threads (same contract as ImFontAtlas::BuildParallelForFn). Compare functions
+//   are then called concurrently and must be thread-safe.
+struct ImGuiTableDataSource
+{
+    void*                       UserData;                   // Passed to CellFn and compare functions
+    ImGuiTableCellFunc          CellFn;                     // Submit the contents of a cell. Called after TableSetColumnIndex(), within PushID(row).
+    ImGuiParallelForFunc        SortParallelForFn;          // Optional: run full sorts of large tables on your own threads.
+    void*                       SortParallelForUserData;    // User data passed to SortParallelForFn.
+
+    // [Internal]
+    int                                 RowsCount;
+    ImVector<ImGuiTableRowCompareFunc>  ColumnCompareFns;   // Compare function for each column index (NULL: the column doesn't affect order)
+    ImVector<ImGuiTableColumnSortSpecs> SortSpecs;          // Sort specs SortedRows was sorted with
+    ImVector<int>                       SortedRows;         // Row index for each displayed position
+    ImVector<int>                       DirtyRows;          // Rows to sort again, see InvalidateRow()
+    ImVector<int>                       TempRows;
+    ImVector<ImU32>                     TempRowsMask;
+    bool                                SortedRowsValid;    // Set to false to sort all rows again
+
+    IMGUI_API ImGuiTableDataSource();
+    IMGUI_API void      SetRowsCount(int rows_count);                           // Rows added at the end are merged at their sorted position on the next Sort()
+    IMGUI_API void      SetColumnCompareFn(int column_n, ImGuiTableRowCompareFunc compare_fn);
+    void                InvalidateRow(int row)                                  { IM_ASSERT(row >= 0); DirtyRows.push_back(row); } // Values of 'row' changed
+    void                InvalidateAll()                                         { SortedRowsValid = false; }    // Values of many rows changed
+    IMGUI_API void      Sort(ImGuiTableSortSpecs* sort_specs);                  // Sort if needed, clearing 'sort_specs->SpecsDirty'. Called by TableDataSourceRows().
+    int                 GetRowAt(int display_n) const                           { return SortedRows[display_n]; }
+};
+
 // Helpers macros to generate 32-bit encoded colors
 #ifdef IMGUI_USE_BGRA_PACKED_COLOR
 #define IM_COL32_R_SHIFT    16
@@ -2350,7 +2565,8 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLines        = 1 << 0,  // Enable anti-aliased lines/borders (*2 the number of triangles for 1.0f wide line or lines thin enough to be drawn using textures, otherwise *3 the number of triangles)
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering.
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
-    ImDrawListFlags_AllowVtxOffset          = 1 << 3   // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_ShapeCache              = 1 << 4   // Reuse tessellation of circles and rectangles of identical size instead of recomputing it (requires ImDrawListSharedData::ShapeCache). Set when 'io.ConfigDrawListShapeCache' is enabled.
 };
 
 // Draw command list
@@ -2584,7 +2800,8 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
-    ImFontAtlasFlags_NoBakedLines       = 1 << 2    // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3    // [BETA] Only bake Basic Latin + Latin Supplement at Build() time and rasterize other glyphs of the requested ranges on demand into a reserved area of the texture, evicting least recently used glyphs when full. See UpdateDynamicGlyphs(). (stb_truetype builder only)
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2630,6 +2847,26 @@ struct ImFontAtlas
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't built texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // [BETA] Build cache: save the output of Build() and restore it on a next run, skipping font loading and rasterization.
+    // - Call after adding fonts and custom rects, e.g. 'if (!atlas->LoadBuildCacheFromDisk(filename)) { atlas->Build(); atlas->SaveBuildCacheToDisk(filename); }'
+    // - Loading fails and returns false when the inputs (font data, ImFontConfig settings, glyph ranges, custom rects, atlas settings) don't match those the cache was saved with.
+    // - The blob stores uncompressed Alpha8 pixels, glyphs and lookup tables. It is only valid for the same build of Dear ImGui. You may memory-map it and use LoadBuildCacheFromMemory().
+    // - Atlases using ImFontAtlasFlags_DynamicGlyphs can't be cached.
+    IMGUI_API bool              LoadBuildCacheFromDisk(const char* filename);
+    IMGUI_API bool              LoadBuildCacheFromMemory(const void* data, size_t data_size);
+    IMGUI_API bool              SaveBuildCacheToDisk(const char* filename);
+    IMGUI_API bool              SaveBuildCacheToMemory(ImVector<char>* out_data);
+
+    // [BETA] Dynamic glyphs (when building with ImFontAtlasFlags_DynamicGlyphs)
+    // - Glyphs looked up during a frame but not present in the texture are queued, then rasterized by UpdateDynamicGlyphs(). They render as the fallback glyph until then (typically for a single frame).
+    // - UpdateDynamicGlyphs() is called by ImGui::NewFrame(). When it returns true, upload the TexDirtyXXX rectangle of the pixels returned by GetTexData*** to your texture, then call ClearTexDirty().
+    //   The renderer backend is expected to do this before rendering: imgui_impl_opengl3 and imgui_impl_dx11 do, other backends don't yet and will keep showing the previous texture contents.
+    // - Requires font data and glyph ranges to stay valid after Build(): don't call ClearInputData() or ClearTexData().
+    // - Glyph lookups queue requests and timestamp glyphs without locking: text rendered from worker threads (see AddDeferredDrawList()) should only use preloaded glyphs.
+    IMGUI_API bool              UpdateDynamicGlyphs();
+    bool                        IsTexDirty() const          { return TexDirtyX1 > TexDirtyX0 && TexDirtyY1 > TexDirtyY0; }
+    void                        ClearTexDirty()             { TexDirtyX0 = TexDirtyY0 = TexDirtyX1 = TexDirtyY1 = 0; }
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -2674,10 +2911,15 @@ struct ImFontAtlas
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
+    ImGuiParallelForFunc        BuildParallelForFn; // [BETA] Optional: run glyph rasterization of Build() on your own threads. Must call 'task_func(task_data, n)' once for every n in [0, tasks_count), from any thread, and return when all calls completed. Output is identical to a serial build. Memory allocator set by SetAllocatorFunctions() needs to be thread-safe. (stb_truetype builder only)
+    void*                       BuildParallelForUserData; // User data passed to BuildParallelForFn.
+    int                         TexDynamicGlyphsHeight; // Height in pixels of the texture area reserved for on demand glyphs when using ImFontAtlasFlags_DynamicGlyphs. Defaults to 512. The final texture height may be rounded up to the next power of two.
+    int                         TexDirtyX0, TexDirtyY0, TexDirtyX1, TexDirtyY1; // Texture rectangle modified by UpdateDynamicGlyphs() since last ClearTexDirty().
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        TexReady;           // Set when texture was built matching current font input
+    int                         BuildGeneration;    // Incremented whenever glyphs or their advances may have changed (build, build cache load, new dynamic glyphs). Used to invalidate measured text layouts.
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
@@ -2698,6 +2940,9 @@ struct ImFontAtlas
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
 
+    // [Internal] Dynamic glyphs
+    ImFontAtlasDynamicGlyphs*   DynamicGlyphs;      // Shelf packer and request queue, allocated by Build() when using ImFontAtlasFlags_DynamicGlyphs
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
     typedef ImFontGlyphRangesBuilder GlyphRangesBuilder; // OBSOLETED in 1.67+
@@ -2730,6 +2975,8 @@ struct ImFont
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
+    int                         DynamicGlyphsStart; // 4     // out // = INT_MAX  // Index of the first glyph rasterized on demand in Glyphs[] (see ImFontAtlasFlags_DynamicGlyphs)
+    ImVector<int>               DynamicGlyphsLastUsed; //    // out //            // Frame of last use of Glyphs[DynamicGlyphsStart + n], -1 when the slot is free
 
     // Methods
     IMGUI_API ImFont();
@@ -2742,10 +2989,10 @@ struct ImFont
 
     // 'max_width' stops rendering after a certain width (could be turned into a 2d size). FLT_MAX to disable.
     // 'wrap_width' enable automatic word-wrapping across multiple lines to fit into given width. 0.0f to disable.
-    IMGUI_API ImVec2            CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL) const; // utf8
+    IMGUI_API ImVec2            CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL, ImVector<int>* out_wrap_eols = NULL) const; // utf8. 'out_wrap_eols' receives word-wrap line ends (as offsets from text_begin), which may be passed back to RenderText().
     IMGUI_API const char*       CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const;
     IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, ImWchar c) const;
-    IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
+    IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false, const int* wrap_eols = NULL, int wrap_eols_count = 0) const; // 'wrap_eols': optional word-wrap line ends from CalcTextSizeA() for the same text, size and wrap_width.
 
     // [Internal] Don't use!
     IMGUI_API void              BuildLookupTable();
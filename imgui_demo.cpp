@@ -6533,7 +6533,7 @@ struct ExampleAppLog
 {
     ImGuiTextBuffer     Buf;
     ImGuiTextFilter     Filter;
-    ImVector<int>       LineOffsets; // Index to lines offset. We maintain this with AddLog() calls.
+    ImGuiTextIndex      LineIndex;   // Index to lines offset. We maintain this with AddLog() calls.
     bool                AutoScroll;  // Keep scrolling if already at the bottom.
 
     ExampleAppLog()
@@ -6545,8 +6545,7 @@ struct ExampleAppLog
     void    Clear()
     {
         Buf.clear();
-        LineOffsets.clear();
-        LineOffsets.push_back(0);
+        LineIndex.clear();
     }
 
     void    AddLog(const char* fmt, ...) IM_FMTARGS(2)
@@ -6556,9 +6555,7 @@ struct ExampleAppLog
         va_start(args, fmt);
         Buf.appendfv(fmt, args);
         va_end(args);
-        for (int new_size = Buf.size(); old_size < new_size; old_size++)
-            if (Buf[old_size] == '\n')
-                LineOffsets.push_back(old_size + 1);
+        LineIndex.append(Buf.begin(), old_size, Buf.size());
     }
 
     void    Draw(const char* title, bool* p_open = NULL)
@@ -6596,17 +6593,16 @@ struct ExampleAppLog
 
         ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
         const char* buf = Buf.begin();
-        const char* buf_end = Buf.end();
         if (Filter.IsActive())
         {
             // In this example we don't use the clipper when Filter is enabled.
             // This is because we don't have a random access on the result on our filter.
             // A real application processing logs with ten of thousands of entries may want to store the result of
             // search/filter.. especially if the filtering function is not trivial (e.g. reg-exp).
-            for (int line_no = 0; line_no < LineOffsets.Size; line_no++)
+            for (int line_no = 0; line_no < LineIndex.size(); line_no++)
             {
-                const char* line_start = buf + LineOffsets[line_no];
-                const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
+                const char* line_start = LineIndex.get_line_begin(buf, line_no);
+                const char* line_end = LineIndex.get_line_end(buf, line_no);
                 if (Filter.PassFilter(line_start, line_end))
                     ImGui::TextUnformatted(line_start, line_end);
             }
@@ -6616,28 +6612,14 @@ struct ExampleAppLog
             // The simplest and easy way to display the entire buffer:
             //   ImGui::TextUnformatted(buf_begin, buf_end);
             // And it'll just work. TextUnformatted() has specialization for large blob of text and will fast-forward
-            // to skip non-visible lines. Here we instead demonstrate using the clipper to only process lines that are
-            // within the visible area.
-            // If you have tens of thousands of items and their processing cost is non-negligible, coarse clipping them
-            // on your side is recommended. Using ImGuiListClipper requires
-            // - A) random access into your data
-            // - B) items all being the  same height,
-            // both of which we can handle since we an array pointing to the beginning of each line of text.
+            // to skip non-visible lines, but it still needs to scan the whole text every frame.
+            // Here we instead use the line index we maintain in AddLog(): TextUnformattedIndexed() only processes
+            // lines within the visible area, which keeps it fast for logs of hundreds of megabytes. It also clips
+            // long lines horizontally, and supports word-wrapping with PushTextWrapPos().
             // When using the filter (in the block of code above) we don't have random access into the data to display
-            // anymore, which is why we don't use the clipper. Storing or skimming through the search result would make
+            // anymore, which is why we don't use the index. Storing or skimming through the search result would make
             // it possible (and would be recommended if you want to search through tens of thousands of entries).
-            ImGuiListClipper clipper;
-            clipper.Begin(LineOffsets.Size);
-            while (clipper.Step())
-            {
-                for (int line_no = clipper.DisplayStart; line_no < clipper.DisplayEnd; line_no++)
-                {
-                    const char* line_start = buf + LineOffsets[line_no];
-                    const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                    ImGui::TextUnformatted(line_start, line_end);
-                }
-            }
-            clipper.End();
+            ImGui::TextUnformattedIndexed(buf, &LineIndex);
         }
         ImGui::PopStyleVar();
 
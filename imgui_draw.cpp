@@ -144,8 +144,11 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// Glyphs may be rasterized on user threads (see ImFontAtlas::BuildParallelForFn): call the allocator directly without IM_ALLOC(), which updates the current context allocation counter.
+static void* ImFontAtlasBuildStbttAlloc(size_t sz) { ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data; ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data); return alloc_func(sz, user_data); }
+static void  ImFontAtlasBuildStbttFree(void* ptr)  { ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data; ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data); free_func(ptr, user_data); }
+#define STBTT_malloc(x,u)   ((void)(u), ImFontAtlasBuildStbttAlloc(x))
+#define STBTT_free(x,u)     ((void)(u), ImFontAtlasBuildStbttFree(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -398,6 +401,46 @@ void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
     ArcFastRadiusCutoff = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC_R(IM_DRAWLIST_ARCFAST_SAMPLE_MAX, CircleSegmentMaxError);
 }
 
+const ImDrawListShapeCacheEntry* ImDrawListShapeCache::Find(const ImDrawListShapeKey& key, ImGuiID key_hash) const
+{
+    const int entry_idx = Map.GetInt(key_hash, 0) - 1;
+    if (entry_idx < 0)
+        return NULL;
+    const ImDrawListShapeCacheEntry* entry = &Entries[entry_idx];
+    return (memcmp(&entry->Key, &key, sizeof(key)) == 0) ? entry : NULL;
+}
+
+void ImDrawListShapeCache::Add(const ImDrawListShapeKey& key, ImGuiID key_hash, const ImDrawVert* vtx, int vtx_count, const ImDrawIdx* idx, int idx_count, unsigned int vtx_base_idx, const ImVec2& origin, ImU32 col)
+{
+    if (vtx_count > IM_DRAWLIST_SHAPE_CACHE_MAX_VTX)
+        return;
+    if (VtxBuffer.Size + vtx_count > IM_DRAWLIST_SHAPE_CACHE_MAX_VTX)
+        Clear();
+
+    ImDrawListShapeCacheEntry entry;
+    entry.Key = key;
+    entry.VtxOffset = VtxBuffer.Size;
+    entry.VtxCount = vtx_count;
+    entry.IdxOffset = IdxBuffer.Size;
+    entry.IdxCount = idx_count;
+    Map.SetInt(key_hash, Entries.Size + 1);
+    Entries.push_back(entry);
+
+    // Store positions relative to origin and replace colors with a mask (shapes only use 'col' or 'col & ~IM_COL32_A_MASK')
+    VtxBuffer.resize(VtxBuffer.Size + vtx_count);
+    ImDrawVert* dst_vtx = VtxBuffer.Data + entry.VtxOffset;
+    for (int n = 0; n < vtx_count; n++, dst_vtx++)
+    {
+        dst_vtx->pos = ImVec2(vtx[n].pos.x - origin.x, vtx[n].pos.y - origin.y);
+        dst_vtx->uv = vtx[n].uv;
+        dst_vtx->col = (vtx[n].col == col) ? ~(ImU32)0 : ~IM_COL32_A_MASK;
+    }
+    IdxBuffer.resize(IdxBuffer.Size + idx_count);
+    ImDrawIdx* dst_idx = IdxBuffer.Data + entry.IdxOffset;
+    for (int n = 0; n < idx_count; n++)
+        dst_idx[n] = (ImDrawIdx)(idx[n] - vtx_base_idx);
+}
+
 // Initialize before use in a new frame. We always have a command ready in the buffer.
 void ImDrawList::_ResetForNewFrame()
 {
@@ -711,6 +754,174 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+#ifdef IMGUI_ENABLE_SSE
+// SSE versions of the per-point loops in AddPolyline(), processing 4 points per iteration as two (x0,y0,x1,y1) registers.
+// - They only process the non-wrapping part of the line and return how many items were done, the scalar loops finish the remainder.
+// - Operations are ordered the same way as IM_NORMALIZE2F_OVER_ZERO()/IM_FIXNORMAL2F() so both paths output the same vertices.
+static inline __m128 ImSseSwapXY(__m128 v)          { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline __m128 ImSseLengthSqr2(__m128 v)      { __m128 sq = _mm_mul_ps(v, v); return _mm_add_ps(sq, ImSseSwapXY(sq)); }
+static inline __m128 ImSseSelect(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+static inline __m128 ImSseNormalize2OverZero(__m128 v)
+{
+    const __m128 d2 = ImSseLengthSqr2(v);
+    return ImSseSelect(_mm_cmpgt_ps(d2, _mm_setzero_ps()), _mm_mul_ps(v, _mm_rsqrt_ps(d2)), v);
+}
+
+static inline __m128 ImSseAverageFixNormal2(__m128 n0, __m128 n1)
+{
+    const __m128 dm = _mm_mul_ps(_mm_add_ps(n0, n1), _mm_set1_ps(0.5f));
+    const __m128 d2 = ImSseLengthSqr2(dm);
+    const __m128 inv_len2 = _mm_min_ps(_mm_div_ps(_mm_set1_ps(1.0f), d2), _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2));
+    return ImSseSelect(_mm_cmpgt_ps(d2, _mm_set1_ps(0.000001f)), _mm_mul_ps(dm, inv_len2), dm);
+}
+
+// Normals of segments [0..count), reading points [0..count]
+static int PolylineCalcNormalsSSE(const ImVec2* points, const int count, ImVec2* out_normals)
+{
+    const __m128 sign_y = _mm_castsi128_ps(_mm_set_epi32((int)0x80000000, 0, (int)0x80000000, 0));
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float* p = &points[i].x;
+        const __m128 d01 = ImSseNormalize2OverZero(_mm_sub_ps(_mm_loadu_ps(p + 2), _mm_loadu_ps(p + 0)));
+        const __m128 d23 = ImSseNormalize2OverZero(_mm_sub_ps(_mm_loadu_ps(p + 6), _mm_loadu_ps(p + 4)));
+        _mm_storeu_ps(&out_normals[i].x, _mm_xor_ps(ImSseSwapXY(d01), sign_y));     // (dy, -dx)
+        _mm_storeu_ps(&out_normals[i + 2].x, _mm_xor_ps(ImSseSwapXY(d23), sign_y));
+    }
+    return i;
+}
+
+// Outer edge points (2 per point) for points [1..count], reading normals [0..count]
+static int PolylineCalcEdges2SSE(const ImVec2* points, const ImVec2* normals, const int count, float half_draw_size, ImVec2* out_points)
+{
+    const __m128 scale = _mm_set1_ps(half_draw_size);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        for (int n = 0; n < 4; n += 2)
+        {
+            const __m128 dm = _mm_mul_ps(ImSseAverageFixNormal2(_mm_loadu_ps(&normals[i + n].x), _mm_loadu_ps(&normals[i + n + 1].x)), scale);
+            const __m128 p = _mm_loadu_ps(&points[i + n + 1].x);
+            const __m128 out_l = _mm_add_ps(p, dm);
+            const __m128 out_r = _mm_sub_ps(p, dm);
+            float* out = &out_points[(i + n + 1) * 2].x;
+            _mm_storeu_ps(out + 0, _mm_movelh_ps(out_l, out_r));
+            _mm_storeu_ps(out + 4, _mm_movehl_ps(out_r, out_l));
+        }
+    }
+    return i;
+}
+
+// Outer and inner edge points (4 per point) for points [1..count], reading normals [0..count]
+static int PolylineCalcEdges4SSE(const ImVec2* points, const ImVec2* normals, const int count, float half_inner_thickness, float aa_size, ImVec2* out_points)
+{
+    const __m128 scale_out = _mm_set1_ps(half_inner_thickness + aa_size);
+    const __m128 scale_in = _mm_set1_ps(half_inner_thickness);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        for (int n = 0; n < 4; n += 2)
+        {
+            const __m128 dm = ImSseAverageFixNormal2(_mm_loadu_ps(&normals[i + n].x), _mm_loadu_ps(&normals[i + n + 1].x));
+            const __m128 dm_out = _mm_mul_ps(dm, scale_out);
+            const __m128 dm_in = _mm_mul_ps(dm, scale_in);
+            const __m128 p = _mm_loadu_ps(&points[i + n + 1].x);
+            const __m128 out_l = _mm_add_ps(p, dm_out);
+            const __m128 in_l = _mm_add_ps(p, dm_in);
+            const __m128 in_r = _mm_sub_ps(p, dm_in);
+            const __m128 out_r = _mm_sub_ps(p, dm_out);
+            float* out = &out_points[(i + n + 1) * 4].x;
+            _mm_storeu_ps(out + 0, _mm_movelh_ps(out_l, in_l));
+            _mm_storeu_ps(out + 4, _mm_movelh_ps(in_r, out_r));
+            _mm_storeu_ps(out + 8, _mm_movehl_ps(in_l, out_l));
+            _mm_storeu_ps(out + 12, _mm_movehl_ps(out_r, in_r));
+        }
+    }
+    return i;
+}
+
+// Write 'blocks_count' blocks of 24 indices, each block being the previous one + 'step'.
+static void ImSseWriteIndexBlocks(ImDrawIdx* dst, const ImDrawIdx* pattern, const ImDrawIdx* step, int blocks_count)
+{
+    const int idx_per_vec = 16 / (int)sizeof(ImDrawIdx);
+    const int vec_count = 24 / idx_per_vec;
+    __m128i v[6], v_step[6];
+    for (int n = 0; n < vec_count; n++)
+    {
+        v[n] = _mm_loadu_si128((const __m128i*)(pattern + n * idx_per_vec));
+        v_step[n] = _mm_loadu_si128((const __m128i*)(step + n * idx_per_vec));
+    }
+    for (int block_n = 0; block_n < blocks_count; block_n++, dst += 24)
+        for (int n = 0; n < vec_count; n++)
+        {
+            _mm_storeu_si128((__m128i*)(dst + n * idx_per_vec), v[n]);
+            v[n] = (sizeof(ImDrawIdx) == 2) ? _mm_add_epi16(v[n], v_step[n]) : _mm_add_epi32(v[n], v_step[n]);
+        }
+}
+
+// Triangle fan indices of AddConvexPolyFilled() for triangles [2..count), 8 triangles per block
+static int ConvexPolyFilledFanIndicesSSE(const int count, unsigned int vtx_inner_idx, ImDrawIdx* idx_write)
+{
+    const int blocks_count = (count - 2) / 8;
+    ImDrawIdx pattern[24], step[24];
+    for (int n = 0; n < 8; n++)
+    {
+        pattern[n * 3 + 0] = (ImDrawIdx)(vtx_inner_idx);                step[n * 3 + 0] = 0;
+        pattern[n * 3 + 1] = (ImDrawIdx)(vtx_inner_idx + ((n + 1) << 1)); step[n * 3 + 1] = 16;
+        pattern[n * 3 + 2] = (ImDrawIdx)(vtx_inner_idx + ((n + 2) << 1)); step[n * 3 + 2] = 16;
+    }
+    ImSseWriteIndexBlocks(idx_write, pattern, step, blocks_count);
+    return blocks_count * 8;
+}
+
+#ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+// Fringe vertices and indices of AddConvexPolyFilled() for points [0..count), reading normals [-1..count)
+// Vertices are written as a single 16 bytes store for pos+uv, followed by the color.
+static int ConvexPolyFilledFringeSSE(const ImVec2* points, const ImVec2* normals, const int count, float half_aa_size, const ImVec2& uv, ImU32 col, ImU32 col_trans, unsigned int vtx_inner_idx, ImDrawVert* vtx_write, ImDrawIdx* idx_write)
+{
+    const __m128 scale = _mm_set1_ps(half_aa_size);
+    const __m128 uv2 = _mm_setr_ps(uv.x, uv.y, uv.x, uv.y);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        for (int n = 0; n < 4; n += 2)
+        {
+            const __m128 dm = _mm_mul_ps(ImSseAverageFixNormal2(_mm_loadu_ps(&normals[i + n - 1].x), _mm_loadu_ps(&normals[i + n].x)), scale);
+            const __m128 p = _mm_loadu_ps(&points[i + n].x);
+            const __m128 inner = _mm_sub_ps(p, dm);
+            const __m128 outer = _mm_add_ps(p, dm);
+            ImDrawVert* vtx = &vtx_write[(i + n) * 2];
+            _mm_storeu_ps(&vtx[0].pos.x, _mm_movelh_ps(inner, uv2)); vtx[0].col = col;
+            _mm_storeu_ps(&vtx[1].pos.x, _mm_movelh_ps(outer, uv2)); vtx[1].col = col_trans;
+            _mm_storeu_ps(&vtx[2].pos.x, _mm_movehl_ps(uv2, inner)); vtx[2].col = col;
+            _mm_storeu_ps(&vtx[3].pos.x, _mm_movehl_ps(uv2, outer)); vtx[3].col = col_trans;
+        }
+    }
+    if (i == 0)
+        return 0;
+
+    // Indices for point n are (inner+2n, inner+2n-2, outer+2n-2, outer+2n-2, outer+2n, inner+2n)
+    ImDrawIdx pattern[24], step[24];
+    const unsigned int vtx_outer_idx = vtx_inner_idx + 1;
+    for (int n = 0; n < 4; n++)
+    {
+        ImDrawIdx* p = &pattern[n * 6];
+        p[0] = (ImDrawIdx)(vtx_inner_idx + n * 2); p[1] = (ImDrawIdx)(vtx_inner_idx + (n - 1) * 2); p[2] = (ImDrawIdx)(vtx_outer_idx + (n - 1) * 2);
+        p[3] = (ImDrawIdx)(vtx_outer_idx + (n - 1) * 2); p[4] = (ImDrawIdx)(vtx_outer_idx + n * 2); p[5] = (ImDrawIdx)(vtx_inner_idx + n * 2);
+    }
+    for (int n = 0; n < 24; n++)
+        step[n] = 8;
+    ImSseWriteIndexBlocks(idx_write, pattern, step, i / 4);
+
+    // First point connects to the last one
+    idx_write[1] = (ImDrawIdx)(vtx_inner_idx + ((count - 1) << 1));
+    idx_write[2] = idx_write[3] = (ImDrawIdx)(vtx_outer_idx + ((count - 1) << 1));
+    return i;
+}
+#endif
+#endif
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -752,7 +963,12 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
+#ifdef IMGUI_ENABLE_SSE
+        const int normals_done = _Data->DisableSSE ? 0 : PolylineCalcNormalsSSE(points, points_count - 1, temp_normals);
+#else
+        const int normals_done = 0;
+#endif
+        for (int i1 = normals_done; i1 < count; i1++)
         {
             const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
             float dx = points[i2].x - points[i1].x;
@@ -789,25 +1005,33 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+#ifdef IMGUI_ENABLE_SSE
+            const int edges_done = _Data->DisableSSE ? 0 : PolylineCalcEdges2SSE(points, temp_normals, points_count - 1, half_draw_size, temp_points);
+#else
+            const int edges_done = 0;
+#endif
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertexes for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
+                if (i1 >= edges_done)
+                {
+                    // Average normals
+                    float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
+                    float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
+                    IM_FIXNORMAL2F(dm_x, dm_y);
+                    dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
+                    dm_y *= half_draw_size;
+
+                    // Add temporary vertexes for the outer edges
+                    ImVec2* out_vtx = &temp_points[i2 * 2];
+                    out_vtx[0].x = points[i2].x + dm_x;
+                    out_vtx[0].y = points[i2].y + dm_y;
+                    out_vtx[1].x = points[i2].x - dm_x;
+                    out_vtx[1].y = points[i2].y - dm_y;
+                }
 
                 if (use_texture)
                 {
@@ -885,31 +1109,39 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+#ifdef IMGUI_ENABLE_SSE
+            const int edges_done = _Data->DisableSSE ? 0 : PolylineCalcEdges4SSE(points, temp_normals, points_count - 1, half_inner_thickness, AA_SIZE, temp_points);
+#else
+            const int edges_done = 0;
+#endif
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
+                if (i1 >= edges_done)
+                {
+                    // Average normals
+                    float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
+                    float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
+                    IM_FIXNORMAL2F(dm_x, dm_y);
+                    float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
+                    float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
+                    float dm_in_x = dm_x * half_inner_thickness;
+                    float dm_in_y = dm_y * half_inner_thickness;
+
+                    // Add temporary vertices
+                    ImVec2* out_vtx = &temp_points[i2 * 4];
+                    out_vtx[0].x = points[i2].x + dm_out_x;
+                    out_vtx[0].y = points[i2].y + dm_out_y;
+                    out_vtx[1].x = points[i2].x + dm_in_x;
+                    out_vtx[1].y = points[i2].y + dm_in_y;
+                    out_vtx[2].x = points[i2].x - dm_in_x;
+                    out_vtx[2].y = points[i2].y - dm_in_y;
+                    out_vtx[3].x = points[i2].x - dm_out_x;
+                    out_vtx[3].y = points[i2].y - dm_out_y;
+                }
 
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
@@ -988,16 +1220,29 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         // Add indexes for fill
         unsigned int vtx_inner_idx = _VtxCurrentIdx;
         unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
-        for (int i = 2; i < points_count; i++)
+#ifdef IMGUI_ENABLE_SSE
+        const int fill_done = _Data->DisableSSE ? 0 : ConvexPolyFilledFanIndicesSSE(points_count, vtx_inner_idx, _IdxWritePtr);
+        _IdxWritePtr += fill_done * 3;
+#else
+        const int fill_done = 0;
+#endif
+        for (int i = 2 + fill_done; i < points_count; i++)
         {
             _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
             _IdxWritePtr += 3;
         }
 
         // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        // (an extra leading slot is allocated so that temp_normals[-1] can hold a copy of the last normal)
+        ImVec2* temp_normals = (ImVec2*)alloca((points_count + 1) * sizeof(ImVec2)) + 1; //-V630
+#ifdef IMGUI_ENABLE_SSE
+        const int normals_done = _Data->DisableSSE ? 0 : PolylineCalcNormalsSSE(points, points_count - 1, temp_normals);
+#else
+        const int normals_done = 0;
+#endif
+        for (int i0 = normals_done; i0 < points_count; i0++)
         {
+            const int i1 = (i0 + 1 == points_count) ? 0 : i0 + 1;
             const ImVec2& p0 = points[i0];
             const ImVec2& p1 = points[i1];
             float dx = p1.x - p0.x;
@@ -1007,7 +1252,15 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             temp_normals[i0].y = -dx;
         }
 
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+        temp_normals[-1] = temp_normals[points_count - 1];
+        const int fringe_done = _Data->DisableSSE ? 0 : ConvexPolyFilledFringeSSE(points, temp_normals, points_count, AA_SIZE * 0.5f, uv, col, col_trans, vtx_inner_idx, _VtxWritePtr, _IdxWritePtr);
+        _VtxWritePtr += fringe_done * 2;
+        _IdxWritePtr += fringe_done * 6;
+#else
+        const int fringe_done = 0;
+#endif
+        for (int i0 = (fringe_done > 0 ? fringe_done : points_count) - 1, i1 = fringe_done; i1 < points_count; i0 = i1++)
         {
             // Average normals
             const ImVec2& n0 = temp_normals[i0];
@@ -1383,17 +1636,103 @@ void ImDrawList::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float th
     PathStroke(col, 0, thickness);
 }
 
+// Shape cache helpers (see ImDrawListShapeCache)
+// - ShapeCacheBegin() emits the shape from cache and returns true on hit. On miss it prepares 'rec' for ShapeCacheEnd().
+// - ShapeCacheEnd() stores the vertices and indices emitted since ShapeCacheBegin().
+struct ImDrawListShapeCacheRecord
+{
+    ImDrawListShapeKey  Key;
+    ImGuiID             KeyHash;
+    int                 VtxStart;               // -1 when not recording
+    int                 IdxStart;
+};
+
+static bool ShapeCacheBegin(ImDrawList* draw_list, ImDrawListShapeCacheRecord* rec, ImDrawListShapeType type, const ImVec2& origin, const ImVec2& size, float rounding, int num_segments, float thickness, ImDrawFlags flags, ImU32 col)
+{
+    rec->VtxStart = -1;
+    ImDrawListShapeCache* cache = draw_list->_Data->ShapeCache;
+    if (!(draw_list->Flags & ImDrawListFlags_ShapeCache) || cache == NULL || draw_list->_Path.Size != 0)
+        return false;
+
+    ImDrawListShapeKey* key = &rec->Key;
+    memset(key, 0, sizeof(*key)); // Key is compared with memcmp()
+    key->Type = type;
+    key->Size = size;
+    key->Rounding = rounding;
+    key->NumSegments = num_segments;
+    key->Thickness = thickness;
+    key->Flags = flags;
+    key->DrawListFlags = draw_list->Flags & (ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill);
+    key->FringeScale = draw_list->_FringeScale;
+    key->TexUvWhitePixel = draw_list->_Data->TexUvWhitePixel;
+    if ((key->DrawListFlags & ImDrawListFlags_AntiAliasedLinesUseTex) && draw_list->_Data->TexUvLines != NULL)
+        key->TexUvLines = ImVec2(draw_list->_Data->TexUvLines[0].x, draw_list->_Data->TexUvLines[0].y);
+    key->CircleSegmentMaxError = draw_list->_Data->CircleSegmentMaxError;
+
+    // Key is made of 32-bit fields, hash it word by word (ImHashData() is too slow to run for every shape)
+    ImU32 key_hash = 2166136261u;
+    for (const ImU32* p = (const ImU32*)key, *p_end = (const ImU32*)(key + 1); p < p_end; p++)
+        key_hash = (key_hash ^ *p) * 16777619u;
+    rec->KeyHash = key_hash;
+
+    const ImDrawListShapeCacheEntry* entry = cache->Find(*key, rec->KeyHash);
+    if (entry == NULL)
+    {
+        cache->Misses++;
+        rec->VtxStart = draw_list->VtxBuffer.Size;
+        rec->IdxStart = draw_list->IdxBuffer.Size;
+        return false;
+    }
+    cache->Hits++;
+
+    draw_list->PrimReserve(entry->IdxCount, entry->VtxCount);
+    const ImDrawVert* src_vtx = &cache->VtxBuffer.Data[entry->VtxOffset];
+    ImDrawVert* dst_vtx = draw_list->_VtxWritePtr;
+    for (int n = 0; n < entry->VtxCount; n++)
+    {
+        dst_vtx[n].pos.x = src_vtx[n].pos.x + origin.x;
+        dst_vtx[n].pos.y = src_vtx[n].pos.y + origin.y;
+        dst_vtx[n].uv = src_vtx[n].uv;
+        dst_vtx[n].col = src_vtx[n].col & col;
+    }
+    const ImDrawIdx* src_idx = &cache->IdxBuffer.Data[entry->IdxOffset];
+    ImDrawIdx* dst_idx = draw_list->_IdxWritePtr;
+    const unsigned int vtx_base_idx = draw_list->_VtxCurrentIdx;
+    for (int n = 0; n < entry->IdxCount; n++)
+        dst_idx[n] = (ImDrawIdx)(src_idx[n] + vtx_base_idx);
+    draw_list->_VtxWritePtr += entry->VtxCount;
+    draw_list->_IdxWritePtr += entry->IdxCount;
+    draw_list->_VtxCurrentIdx += entry->VtxCount;
+    return true;
+}
+
+static void ShapeCacheEnd(ImDrawList* draw_list, const ImDrawListShapeCacheRecord& rec, const ImVec2& origin, ImU32 col)
+{
+    if (rec.VtxStart < 0)
+        return;
+    const int vtx_count = draw_list->VtxBuffer.Size - rec.VtxStart;
+    const int idx_count = draw_list->IdxBuffer.Size - rec.IdxStart;
+    if (vtx_count == 0)
+        return;
+    const unsigned int vtx_base_idx = draw_list->_VtxCurrentIdx - vtx_count; // PrimReserve() may have reset _VtxCurrentIdx while emitting the shape
+    draw_list->_Data->ShapeCache->Add(rec.Key, rec.KeyHash, &draw_list->VtxBuffer.Data[rec.VtxStart], vtx_count, &draw_list->IdxBuffer.Data[rec.IdxStart], idx_count, vtx_base_idx, origin, col);
+}
+
 // p_min = upper-left, p_max = lower-right
 // Note we don't render 1 pixels sized rectangles properly.
 void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags, float thickness)
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    ImDrawListShapeCacheRecord cache_rec;
+    if (ShapeCacheBegin(this, &cache_rec, ImDrawListShapeType_Rect, p_min, p_max - p_min, rounding, 0, thickness, flags, col))
+        return;
     if (Flags & ImDrawListFlags_AntiAliasedLines)
         PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), rounding, flags);
     else
         PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.49f, 0.49f), rounding, flags); // Better looking lower-right corner and rounded non-AA shapes.
     PathStroke(col, ImDrawFlags_Closed, thickness);
+    ShapeCacheEnd(this, cache_rec, p_min, col);
 }
 
 void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags)
@@ -1407,8 +1746,12 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
     }
     else
     {
+        ImDrawListShapeCacheRecord cache_rec;
+        if (ShapeCacheBegin(this, &cache_rec, ImDrawListShapeType_RectFilled, p_min, p_max - p_min, rounding, 0, 0.0f, flags, col))
+            return;
         PathRect(p_min, p_max, rounding, flags);
         PathFillConvex(col);
+        ShapeCacheEnd(this, cache_rec, p_min, col);
     }
 }
 
@@ -1491,6 +1834,10 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
         num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
     }
 
+    ImDrawListShapeCacheRecord cache_rec;
+    if (ShapeCacheBegin(this, &cache_rec, ImDrawListShapeType_Circle, center, ImVec2(radius, radius), 0.0f, num_segments, thickness, 0, col))
+        return;
+
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
     if (num_segments == 12)
@@ -1498,6 +1845,7 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     else
         PathArcTo(center, radius - 0.5f, 0.0f, a_max, num_segments - 1);
     PathStroke(col, ImDrawFlags_Closed, thickness);
+    ShapeCacheEnd(this, cache_rec, center, col);
 }
 
 void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col, int num_segments)
@@ -1517,6 +1865,10 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
         num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
     }
 
+    ImDrawListShapeCacheRecord cache_rec;
+    if (ShapeCacheBegin(this, &cache_rec, ImDrawListShapeType_CircleFilled, center, ImVec2(radius, radius), 0.0f, num_segments, 0.0f, 0, col))
+        return;
+
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
     if (num_segments == 12)
@@ -1524,6 +1876,7 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     else
         PathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
     PathFillConvex(col);
+    ShapeCacheEnd(this, cache_rec, center, col);
 }
 
 // Guaranteed to honor 'num_segments'
@@ -1810,6 +2163,99 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
         draw_list->AddDrawCmd();
 }
 
+// Copy everything submitted to 'draw_list' since the given buffer offsets (typically recorded the same frame).
+// Returns false when the range cannot be replayed (user callbacks, or too many vertices for 16-bit indices).
+bool ImDrawListSnapshot::Capture(const ImDrawList* draw_list, int cmd_start, int idx_start, int vtx_start)
+{
+    Clear();
+    const int vtx_count = draw_list->VtxBuffer.Size - vtx_start;
+    if (sizeof(ImDrawIdx) == 2 && vtx_count >= (1 << 16))
+        return false;
+    for (int cmd_n = cmd_start; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+    {
+        // The first command may have started before the range, clip it
+        const ImDrawCmd* src_cmd = &draw_list->CmdBuffer.Data[cmd_n];
+        if (src_cmd->UserCallback != NULL)
+            return false;
+        const int src_idx_start = ImMax((int)src_cmd->IdxOffset, idx_start);
+        const int src_idx_end = (int)(src_cmd->IdxOffset + src_cmd->ElemCount);
+        if (src_idx_end <= src_idx_start)
+            continue;
+
+        ImDrawCmd cmd = *src_cmd;
+        cmd.IdxOffset = (unsigned int)IdxBuffer.Size;
+        cmd.ElemCount = (unsigned int)(src_idx_end - src_idx_start);
+        cmd.VtxOffset = 0;
+        CmdBuffer.push_back(cmd);
+
+        // Rebase indices on the first vertex of the range
+        const int idx_rebase = (int)src_cmd->VtxOffset - vtx_start;
+        const ImDrawIdx* src_idx = draw_list->IdxBuffer.Data + src_idx_start;
+        IdxBuffer.resize(IdxBuffer.Size + (int)cmd.ElemCount);
+        ImDrawIdx* dst_idx = IdxBuffer.Data + cmd.IdxOffset;
+        for (unsigned int n = 0; n < cmd.ElemCount; n++)
+            dst_idx[n] = (ImDrawIdx)(src_idx[n] + idx_rebase);
+    }
+    VtxBuffer.resize(vtx_count);
+    if (vtx_count > 0)
+        memcpy(VtxBuffer.Data, draw_list->VtxBuffer.Data + vtx_start, (size_t)vtx_count * sizeof(ImDrawVert));
+    return true;
+}
+
+// Append the recorded range at the end of 'draw_list'.
+// Vertices are copied as-is, indices only need to be offset by the current vertex index (or not at all when a new VtxOffset is started).
+// Returns false (and leaves 'draw_list' untouched) when the vertices don't fit in 16-bit indices and ImDrawListFlags_AllowVtxOffset is not set.
+bool ImDrawListSnapshot::Replay(ImDrawList* draw_list) const
+{
+    if (CmdBuffer.Size == 0)
+        return true;
+    if (sizeof(ImDrawIdx) == 2 && draw_list->_VtxCurrentIdx + VtxBuffer.Size >= (1 << 16))
+    {
+        if (!(draw_list->Flags & ImDrawListFlags_AllowVtxOffset))
+            return false;
+        draw_list->_CmdHeader.VtxOffset = draw_list->VtxBuffer.Size;
+        draw_list->_OnChangedVtxOffset();
+    }
+
+    const unsigned int idx_base = draw_list->_VtxCurrentIdx;
+    const int vtx_old_size = draw_list->VtxBuffer.Size;
+    draw_list->VtxBuffer.resize(vtx_old_size + VtxBuffer.Size);
+    memcpy(draw_list->VtxBuffer.Data + vtx_old_size, VtxBuffer.Data, (size_t)VtxBuffer.Size * sizeof(ImDrawVert));
+
+    const int idx_old_size = draw_list->IdxBuffer.Size;
+    draw_list->IdxBuffer.resize(idx_old_size + IdxBuffer.Size);
+    ImDrawIdx* dst_idx = draw_list->IdxBuffer.Data + idx_old_size;
+    if (idx_base == 0)
+        memcpy(dst_idx, IdxBuffer.Data, (size_t)IdxBuffer.Size * sizeof(ImDrawIdx));
+    else
+        for (int n = 0; n < IdxBuffer.Size; n++)
+            dst_idx[n] = (ImDrawIdx)(IdxBuffer.Data[n] + idx_base);
+
+    for (int cmd_n = 0; cmd_n < CmdBuffer.Size; cmd_n++)
+    {
+        ImDrawCmd cmd = CmdBuffer.Data[cmd_n];
+        cmd.IdxOffset += (unsigned int)idx_old_size;
+        cmd.VtxOffset = draw_list->_CmdHeader.VtxOffset;
+
+        // Reuse an empty trailing command or merge with the previous one when possible
+        ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
+        if (curr_cmd->ElemCount == 0 && curr_cmd->UserCallback == NULL)
+            *curr_cmd = cmd;
+        else if (ImDrawCmd_HeaderCompare(curr_cmd, &cmd) == 0 && curr_cmd->UserCallback == NULL && curr_cmd->IdxOffset + curr_cmd->ElemCount == cmd.IdxOffset)
+            curr_cmd->ElemCount += cmd.ElemCount;
+        else
+            draw_list->CmdBuffer.push_back(cmd);
+    }
+
+    // Following primitives are appended to a command matching the current header
+    if (ImDrawCmd_HeaderCompare(&draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1], &draw_list->_CmdHeader) != 0)
+        draw_list->AddDrawCmd();
+    draw_list->_VtxCurrentIdx += (unsigned int)VtxBuffer.Size;
+    draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size;
+    draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawData
 //-----------------------------------------------------------------------------
@@ -1973,6 +2419,7 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    TexDynamicGlyphsHeight = 512;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2022,6 +2469,9 @@ void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     Fonts.clear_delete();
+    if (DynamicGlyphs)
+        IM_DELETE(DynamicGlyphs);
+    DynamicGlyphs = NULL;
     TexReady = false;
 }
 
@@ -2254,20 +2704,14 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
     return true;
 }
 
-bool    ImFontAtlas::Build()
+// Select builder
+// - Note that we do not reassign to atlas->FontBuilderIO, since it is likely to point to static data which
+//   may mess with some hot-reloading schemes. If you need to assign to this (for dynamic selection) AND are
+//   using a hot-reloading scheme that messes up static data, store your own instance of ImFontBuilderIO somewhere
+//   and point to it instead of pointing directly to return value of the GetBuilderXXX functions.
+static const ImFontBuilderIO* ImFontAtlasGetBuilderIO(const ImFontAtlas* atlas)
 {
-    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
-
-    // Default font is none are specified
-    if (ConfigData.Size == 0)
-        AddFontDefault();
-
-    // Select builder
-    // - Note that we do not reassign to atlas->FontBuilderIO, since it is likely to point to static data which
-    //   may mess with some hot-reloading schemes. If you need to assign to this (for dynamic selection) AND are
-    //   using a hot-reloading scheme that messes up static data, store your own instance of ImFontBuilderIO somewhere
-    //   and point to it instead of pointing directly to return value of the GetBuilderXXX functions.
-    const ImFontBuilderIO* builder_io = FontBuilderIO;
+    const ImFontBuilderIO* builder_io = atlas->FontBuilderIO;
     if (builder_io == NULL)
     {
 #ifdef IMGUI_ENABLE_FREETYPE
@@ -2278,11 +2722,320 @@ bool    ImFontAtlas::Build()
         IM_ASSERT(0); // Invalid Build function
 #endif
     }
+    return builder_io;
+}
+
+bool    ImFontAtlas::Build()
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+
+    // Default font is none are specified
+    if (ConfigData.Size == 0)
+        AddFontDefault();
+
+    // Dynamic glyphs storage is recreated by builders supporting it
+    if (DynamicGlyphs)
+        IM_DELETE(DynamicGlyphs);
+    DynamicGlyphs = NULL;
+    ClearTexDirty();
 
     // Build
+    const ImFontBuilderIO* builder_io = ImFontAtlasGetBuilderIO(this);
     return builder_io->FontBuilder_Build(this);
 }
 
+// Rasterize glyphs missed since last call (see ImFontAtlasFlags_DynamicGlyphs). Return true if the texture was modified.
+bool    ImFontAtlas::UpdateDynamicGlyphs()
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    if (DynamicGlyphs == NULL)
+        return false;
+    DynamicGlyphs->FrameCount++;
+    if (DynamicGlyphs->Requests.Size == 0)
+        return false;
+
+    const ImFontBuilderIO* builder_io = ImFontAtlasGetBuilderIO(this);
+    if (builder_io->FontBuilder_UpdateDynamicGlyphs == NULL)
+    {
+        DynamicGlyphs->Requests.clear();
+        return false;
+    }
+    if (!builder_io->FontBuilder_UpdateDynamicGlyphs(this))
+        return false;
+    BuildGeneration++;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Build cache: output of Build() serialized as a binary blob
+// Layout: ImFontAtlasBuildCacheHeader, Alpha8 pixels, custom rects positions, then for each font: ImFontAtlasBuildCacheFont, Glyphs[], IndexAdvanceX[], IndexLookup[]
+//-----------------------------------------------------------------------------
+
+#define IM_FONT_ATLAS_BUILD_CACHE_MAGIC     0x41464D49  // "IMFA"
+
+struct ImFontAtlasBuildCacheHeader
+{
+    ImU32   Magic;
+    ImU32   InputsHash;             // = ImFontAtlasCalcBuildInputsHash()
+    int     TexWidth, TexHeight;
+    int     FontsCount;
+    int     CustomRectsCount;
+    ImVec2  TexUvScale;
+    ImVec2  TexUvWhitePixel;
+    ImVec4  TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct ImFontAtlasBuildCacheFont
+{
+    float   FontSize, Ascent, Descent, FallbackAdvanceX;
+    int     MetricsTotalSurface;
+    int     ConfigDataCount;
+    ImWchar FallbackChar, EllipsisChar, DotChar;
+    int     GlyphsCount;
+    int     IndexCount;             // Size of IndexAdvanceX[] and IndexLookup[]
+    int     FallbackGlyphIndex;     // Index into Glyphs[], -1 if none
+    ImU8    Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8];
+};
+
+struct ImFontAtlasBuildCacheReader
+{
+    const char* Ptr;
+    const char* End;
+    bool Read(void* dst, size_t size) { if ((size_t)(End - Ptr) < size) return false; if (dst) memcpy(dst, Ptr, size); Ptr += size; return true; }
+};
+
+static void ImFontAtlasBuildCacheWrite(ImVector<char>* buf, const void* data, size_t size)
+{
+    const int off = buf->Size;
+    buf->resize(off + (int)size);
+    memcpy(buf->Data + off, data, size);
+}
+
+static int ImFontAtlasFindFontIndex(const ImFontAtlas* atlas, const ImFont* font)
+{
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+        if (atlas->Fonts[font_n] == font)
+            return font_n;
+    return -1;
+}
+
+// Hash everything affecting the output of Build(), as well as the layout of the cached structures.
+static ImU32 ImFontAtlasCalcBuildInputsHash(ImFontAtlas* atlas)
+{
+    const int build_info[] = { IMGUI_VERSION_NUM, (int)sizeof(ImWchar), (int)sizeof(ImFontGlyph), (int)sizeof(ImFontAtlasBuildCacheHeader), (int)sizeof(ImFontAtlasBuildCacheFont),
+        atlas->Flags, atlas->TexDesiredWidth, atlas->TexGlyphPadding, (int)atlas->FontBuilderFlags, atlas->FontBuilderIO != NULL, atlas->Fonts.Size };
+    ImU32 hash = ImHashData(build_info, sizeof(build_info), 0);
+    for (int i = 0; i < atlas->ConfigData.Size; i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[i];
+        const float cfg_floats[] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX, cfg.RasterizerMultiply };
+        const int cfg_ints[] = { cfg.FontDataSize, cfg.FontNo, cfg.OversampleH, cfg.OversampleV, cfg.PixelSnapH, cfg.MergeMode, (int)cfg.FontBuilderFlags, (int)cfg.EllipsisChar, ImFontAtlasFindFontIndex(atlas, cfg.DstFont) };
+        hash = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, hash);
+        hash = ImHashData(cfg_floats, sizeof(cfg_floats), hash);
+        hash = ImHashData(cfg_ints, sizeof(cfg_ints), hash);
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_count = 0;
+        while (ranges[ranges_count] && ranges[ranges_count + 1])
+            ranges_count += 2;
+        hash = ImHashData(ranges, sizeof(ImWchar) * ranges_count, hash);
+    }
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlasCustomRect& r = atlas->CustomRects[i];
+        const float rect_floats[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        const int rect_ints[] = { r.Width, r.Height, (int)r.GlyphID, ImFontAtlasFindFontIndex(atlas, r.Font) };
+        hash = ImHashData(rect_floats, sizeof(rect_floats), hash);
+        hash = ImHashData(rect_ints, sizeof(rect_ints), hash);
+    }
+    return hash;
+}
+
+bool    ImFontAtlas::SaveBuildCacheToMemory(ImVector<char>* out_data)
+{
+    out_data->resize(0);
+    if (!TexReady || TexPixelsAlpha8 == NULL || DynamicGlyphs != NULL)
+        return false;
+
+    ImFontAtlasBuildCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = IM_FONT_ATLAS_BUILD_CACHE_MAGIC;
+    header.InputsHash = ImFontAtlasCalcBuildInputsHash(this);
+    header.TexWidth = TexWidth;
+    header.TexHeight = TexHeight;
+    header.FontsCount = Fonts.Size;
+    header.CustomRectsCount = CustomRects.Size;
+    header.TexUvScale = TexUvScale;
+    header.TexUvWhitePixel = TexUvWhitePixel;
+    memcpy(header.TexUvLines, TexUvLines, sizeof(TexUvLines));
+    ImFontAtlasBuildCacheWrite(out_data, &header, sizeof(header));
+    ImFontAtlasBuildCacheWrite(out_data, TexPixelsAlpha8, (size_t)TexWidth * (size_t)TexHeight);
+    for (int i = 0; i < CustomRects.Size; i++)
+    {
+        ImFontAtlasBuildCacheWrite(out_data, &CustomRects[i].X, sizeof(CustomRects[i].X));
+        ImFontAtlasBuildCacheWrite(out_data, &CustomRects[i].Y, sizeof(CustomRects[i].Y));
+    }
+    for (int i = 0; i < Fonts.Size; i++)
+    {
+        const ImFont* font = Fonts[i];
+        ImFontAtlasBuildCacheFont font_header;
+        memset(&font_header, 0, sizeof(font_header));
+        font_header.FontSize = font->FontSize;
+        font_header.Ascent = font->Ascent;
+        font_header.Descent = font->Descent;
+        font_header.FallbackAdvanceX = font->FallbackAdvanceX;
+        font_header.MetricsTotalSurface = font->MetricsTotalSurface;
+        font_header.ConfigDataCount = font->ConfigDataCount;
+        font_header.FallbackChar = font->FallbackChar;
+        font_header.EllipsisChar = font->EllipsisChar;
+        font_header.DotChar = font->DotChar;
+        font_header.GlyphsCount = font->Glyphs.Size;
+        font_header.IndexCount = font->IndexLookup.Size;
+        font_header.FallbackGlyphIndex = font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1;
+        memcpy(font_header.Used4kPagesMap, font->Used4kPagesMap, sizeof(font_header.Used4kPagesMap));
+        ImFontAtlasBuildCacheWrite(out_data, &font_header, sizeof(font_header));
+        ImFontAtlasBuildCacheWrite(out_data, font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+        ImFontAtlasBuildCacheWrite(out_data, font->IndexAdvanceX.Data, (size_t)font->IndexAdvanceX.size_in_bytes());
+        ImFontAtlasBuildCacheWrite(out_data, font->IndexLookup.Data, (size_t)font->IndexLookup.size_in_bytes());
+    }
+    return true;
+}
+
+// Called a first time with apply=false to validate the whole blob, so a truncated or mismatching cache leaves the atlas untouched.
+static bool ImFontAtlasReadBuildCache(ImFontAtlas* atlas, const void* data, size_t data_size, bool apply)
+{
+    ImFontAtlasBuildCacheReader reader;
+    reader.Ptr = (const char*)data;
+    reader.End = reader.Ptr + data_size;
+
+    ImFontAtlasBuildCacheHeader header;
+    if (!reader.Read(&header, sizeof(header)))
+        return false;
+    if (!apply && (header.Magic != IM_FONT_ATLAS_BUILD_CACHE_MAGIC || header.FontsCount != atlas->Fonts.Size || header.CustomRectsCount != atlas->CustomRects.Size || header.TexWidth <= 0 || header.TexHeight <= 0 || header.InputsHash != ImFontAtlasCalcBuildInputsHash(atlas)))
+        return false;
+    if (apply)
+    {
+        atlas->ClearTexData();
+        atlas->TexID = (ImTextureID)NULL;
+        atlas->TexWidth = header.TexWidth;
+        atlas->TexHeight = header.TexHeight;
+        atlas->TexUvScale = header.TexUvScale;
+        atlas->TexUvWhitePixel = header.TexUvWhitePixel;
+        memcpy(atlas->TexUvLines, header.TexUvLines, sizeof(atlas->TexUvLines));
+        atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)header.TexWidth * (size_t)header.TexHeight);
+    }
+    if (!reader.Read(apply ? atlas->TexPixelsAlpha8 : NULL, (size_t)header.TexWidth * (size_t)header.TexHeight))
+        return false;
+    for (int i = 0; i < header.CustomRectsCount; i++)
+    {
+        ImFontAtlasCustomRect* r = apply ? &atlas->CustomRects[i] : NULL;
+        if (!reader.Read(r ? &r->X : NULL, sizeof(r->X)) || !reader.Read(r ? &r->Y : NULL, sizeof(r->Y)))
+            return false;
+    }
+
+    for (int font_n = 0; font_n < header.FontsCount; font_n++)
+    {
+        ImFontAtlasBuildCacheFont font_header;
+        if (!reader.Read(&font_header, sizeof(font_header)))
+            return false;
+        if (font_header.GlyphsCount < 0 || font_header.IndexCount < 0 || font_header.FallbackGlyphIndex < -1 || font_header.FallbackGlyphIndex >= font_header.GlyphsCount)
+            return false;
+        ImFont* font = NULL;
+        if (apply)
+        {
+            font = atlas->Fonts[font_n];
+            font->ClearOutputData();
+            font->FontSize = font_header.FontSize;
+            font->Ascent = font_header.Ascent;
+            font->Descent = font_header.Descent;
+            font->FallbackAdvanceX = font_header.FallbackAdvanceX;
+            font->MetricsTotalSurface = font_header.MetricsTotalSurface;
+            font->ConfigDataCount = (short)font_header.ConfigDataCount;
+            font->FallbackChar = font_header.FallbackChar;
+            font->EllipsisChar = font_header.EllipsisChar;
+            font->DotChar = font_header.DotChar;
+            memcpy(font->Used4kPagesMap, font_header.Used4kPagesMap, sizeof(font->Used4kPagesMap));
+            font->ContainerAtlas = atlas;
+            for (int cfg_n = 0; cfg_n < atlas->ConfigData.Size && font->ConfigData == NULL; cfg_n++)
+                if (atlas->ConfigData[cfg_n].DstFont == font)
+                    font->ConfigData = &atlas->ConfigData[cfg_n];
+            font->Glyphs.resize(font_header.GlyphsCount);
+            font->IndexAdvanceX.resize(font_header.IndexCount);
+            font->IndexLookup.resize(font_header.IndexCount);
+        }
+        if (!reader.Read(font ? font->Glyphs.Data : NULL, sizeof(ImFontGlyph) * (size_t)font_header.GlyphsCount) ||
+            !reader.Read(font ? font->IndexAdvanceX.Data : NULL, sizeof(float) * (size_t)font_header.IndexCount) ||
+            !reader.Read(font ? font->IndexLookup.Data : NULL, sizeof(ImWchar) * (size_t)font_header.IndexCount))
+            return false;
+        if (!apply)
+        {
+            // FindGlyph() indexes Glyphs[] with the lookup entries, reject any out of range (the blob may be unaligned)
+            const char* index_lookup = reader.Ptr - sizeof(ImWchar) * (size_t)font_header.IndexCount;
+            for (int n = 0; n < font_header.IndexCount; n++)
+            {
+                ImWchar glyph_idx;
+                memcpy(&glyph_idx, index_lookup + sizeof(ImWchar) * (size_t)n, sizeof(ImWchar));
+                if (glyph_idx != (ImWchar)-1 && (unsigned int)glyph_idx >= (unsigned int)font_header.GlyphsCount)
+                    return false;
+            }
+        }
+        if (font)
+        {
+            font->FallbackGlyph = (font_header.FallbackGlyphIndex >= 0) ? &font->Glyphs[font_header.FallbackGlyphIndex] : NULL;
+            font->DirtyLookupTables = false;
+        }
+    }
+    if (apply)
+    {
+        atlas->TexReady = true;
+        atlas->BuildGeneration++;
+    }
+    return reader.Ptr == reader.End;
+}
+
+bool    ImFontAtlas::LoadBuildCacheFromMemory(const void* data, size_t data_size)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    if (Flags & ImFontAtlasFlags_DynamicGlyphs)
+        return false;
+
+    // Register the same inputs as Build() would, so the inputs hash matches
+    if (ConfigData.Size == 0)
+        AddFontDefault();
+    ImFontAtlasBuildInit(this);
+    if (!ImFontAtlasReadBuildCache(this, data, data_size, false))
+        return false;
+
+    if (DynamicGlyphs)
+        IM_DELETE(DynamicGlyphs);
+    DynamicGlyphs = NULL;
+    ClearTexDirty();
+    return ImFontAtlasReadBuildCache(this, data, data_size, true);
+}
+
+bool    ImFontAtlas::LoadBuildCacheFromDisk(const char* filename)
+{
+    size_t file_data_size = 0;
+    void* file_data = ImFileLoadToMemory(filename, "rb", &file_data_size);
+    if (!file_data)
+        return false;
+    const bool ret = LoadBuildCacheFromMemory(file_data, file_data_size);
+    IM_FREE(file_data);
+    return ret;
+}
+
+bool    ImFontAtlas::SaveBuildCacheToDisk(const char* filename)
+{
+    ImVector<char> data;
+    if (!SaveBuildCacheToMemory(&data))
+        return false;
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    const bool ret = ImFileWrite(data.Data, 1, (ImU64)data.Size, f) == (ImU64)data.Size;
+    ImFileClose(f);
+    return ret;
+}
+
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
 {
     for (unsigned int i = 0; i < 256; i++)
@@ -2300,6 +3053,28 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             data[i] = table[data[i]];
 }
 
+static ImGuiID ImFontAtlasDynamicGlyphKey(int font_n, unsigned int codepoint)
+{
+    return ((ImGuiID)font_n << 21) | codepoint;
+}
+
+// Queue a glyph missed by ImFont::FindGlyph() (see ImFontAtlasFlags_DynamicGlyphs)
+void    ImFontAtlasRequestDynamicGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c)
+{
+    const int font_n = ImFontAtlasFindFontIndex(atlas, font);
+    if (font_n == -1) // e.g. InputText() password font
+        return;
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    int* state = dyn->RequestsState.GetIntRef(ImFontAtlasDynamicGlyphKey(font_n, (unsigned int)c), 0);
+    if (*state != 0)
+        return;
+    *state = 1;
+    ImFontAtlasDynamicRequest req;
+    req.Font = (ImFont*)font;
+    req.Codepoint = c;
+    dyn->Requests.push_back(req);
+}
+
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 // Temporary data for one source font (multiple source fonts can be merged into one destination ImFont)
 // (C++03 doesn't allow instancing ImVector<> with function-local types so we declare the type here.)
@@ -2326,6 +3101,56 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Rasterization is split in tasks of up to IM_FONT_BUILD_RASTER_TASK_GLYPHS glyphs from a same source font, writing into disjoint rectangles of the texture.
+#define IM_FONT_BUILD_RASTER_TASK_GLYPHS    64
+
+// With ImFontAtlasFlags_DynamicGlyphs, only codepoints up to IM_FONT_DYNAMIC_GLYPHS_PRELOAD_LAST are rasterized by Build(), others on demand.
+#define IM_FONT_DYNAMIC_GLYPHS_PRELOAD_LAST 0x00FF
+
+struct ImFontBuildRasterTask
+{
+    int                 SrcIndex;           // Index into src_tmp_array[]
+    int                 GlyphStart;         // Index into ImFontBuildSrcData::GlyphsList[]
+    int                 GlyphCount;
+};
+
+struct ImFontBuildRasterData
+{
+    ImFontAtlas*                    Atlas;
+    ImFontBuildSrcData*             SrcData;
+    const stbtt_pack_context*       PackContext;
+    ImVector<ImFontBuildRasterTask> Tasks;
+};
+
+static void ImFontAtlasBuildRasterTask(void* task_data, int task_n)
+{
+    ImFontBuildRasterData* data = (ImFontBuildRasterData*)task_data;
+    const ImFontBuildRasterTask& task = data->Tasks[task_n];
+    ImFontAtlas* atlas = data->Atlas;
+    ImFontConfig& cfg = atlas->ConfigData[task.SrcIndex];
+    ImFontBuildSrcData& src_tmp = data->SrcData[task.SrcIndex];
+
+    // stbtt_PackFontRangesRenderIntoRects() temporarily modifies the pack context, so each task uses its own copy.
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_pack_range range = src_tmp.PackRange;
+    range.array_of_unicode_codepoints = src_tmp.GlyphsList.Data + task.GlyphStart;
+    range.num_chars = task.GlyphCount;
+    range.chardata_for_range = src_tmp.PackedChars + task.GlyphStart;
+    stbrp_rect* rects = src_tmp.Rects + task.GlyphStart;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < task.GlyphCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2343,6 +3168,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     IM_ASSERT(atlas->ConfigData.Size > 0);
 
     ImFontAtlasBuildInit(atlas);
+    const bool dynamic_glyphs = (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) != 0;
 
     // Clear atlas
     atlas->TexID = (ImTextureID)NULL;
@@ -2387,6 +3213,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.SrcRanges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
         for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
             src_tmp.GlyphsHighest = ImMax(src_tmp.GlyphsHighest, (int)src_range[1]);
+        if (dynamic_glyphs)
+            src_tmp.GlyphsHighest = ImMin(src_tmp.GlyphsHighest, IM_FONT_DYNAMIC_GLYPHS_PRELOAD_LAST);
         dst_tmp.SrcCount++;
         dst_tmp.GlyphsHighest = ImMax(dst_tmp.GlyphsHighest, src_tmp.GlyphsHighest);
     }
@@ -2402,7 +3230,9 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
 
         for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
-            for (unsigned int codepoint = src_range[0]; codepoint <= src_range[1]; codepoint++)
+        {
+            const unsigned int codepoint_last = ImMin((unsigned int)src_range[1], (unsigned int)src_tmp.GlyphsHighest);
+            for (unsigned int codepoint = src_range[0]; codepoint <= codepoint_last; codepoint++)
             {
                 if (dst_tmp.GlyphsSet.TestBit(codepoint))    // Don't overwrite existing glyphs. We could make this an option for MergeMode (e.g. MergeOverwrite==true)
                     continue;
@@ -2416,6 +3246,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                 dst_tmp.GlyphsSet.SetBit(codepoint);
                 total_glyphs_count++;
             }
+        }
     }
 
     // 3. Unpack our bit map into a flat list (we now have all the Unicode points that we know are requested _and_ available _and_ not overlapping another)
@@ -2514,6 +3345,10 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 7. Allocate texture
+    // With dynamic glyphs we reserve an empty area at the bottom of the texture (which also receives the extra height added by power-of-two rounding).
+    const int dynamic_area_y0 = atlas->TexHeight;
+    if (dynamic_glyphs)
+        atlas->TexHeight += atlas->TexDynamicGlyphsHeight;
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
@@ -2522,37 +3357,38 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Glyphs are packed in disjoint rectangles so tasks can run in any order, or concurrently when the user provided BuildParallelForFn.
+    ImFontBuildRasterData raster_data;
+    raster_data.Atlas = atlas;
+    raster_data.SrcData = src_tmp_array.Data;
+    raster_data.PackContext = &spc;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += IM_FONT_BUILD_RASTER_TASK_GLYPHS)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRasterTask task;
+            task.SrcIndex = src_i;
+            task.GlyphStart = glyph_i;
+            task.GlyphCount = ImMin(src_tmp_array[src_i].GlyphsCount - glyph_i, IM_FONT_BUILD_RASTER_TASK_GLYPHS);
+            raster_data.Tasks.push_back(task);
         }
-        src_tmp.Rects = NULL;
-    }
+    if (atlas->BuildParallelForFn != NULL && raster_data.Tasks.Size > 1)
+        atlas->BuildParallelForFn(atlas->BuildParallelForUserData, raster_data.Tasks.Size, ImFontAtlasBuildRasterTask, &raster_data);
+    else
+        for (int task_n = 0; task_n < raster_data.Tasks.Size; task_n++)
+            ImFontAtlasBuildRasterTask(&raster_data, task_n);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
     buf_rects.clear();
 
     // 9. Setup ImFont and glyphs for runtime
+    // (with dynamic glyphs, we still setup fonts which have no preloaded glyphs)
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
+        if (src_tmp.GlyphsCount == 0 && !dynamic_glyphs)
             continue;
 
         // When merging fonts with MergeMode=true:
@@ -2587,13 +3423,282 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     src_tmp_array.clear_destruct();
 
     ImFontAtlasBuildFinish(atlas);
+
+    // Glyphs added from now on are rasterized on demand
+    if (dynamic_glyphs)
+    {
+        atlas->DynamicGlyphs = IM_NEW(ImFontAtlasDynamicGlyphs)();
+        atlas->DynamicGlyphs->AreaY0 = dynamic_area_y0;
+        atlas->DynamicGlyphs->AreaY1 = atlas->TexHeight;
+        for (int i = 0; i < atlas->Fonts.Size; i++)
+        {
+            atlas->Fonts[i]->DynamicGlyphsStart = atlas->Fonts[i]->Glyphs.Size;
+            atlas->Fonts[i]->DynamicGlyphsLastUsed.clear();
+        }
+    }
     return true;
 }
 
+// Remove all glyphs of a shelf from their font. They will be requested again if they are used later.
+static void ImFontAtlasDynamicGlyphsEvictShelf(ImFontAtlas* atlas, int shelf_n)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    for (int n = 0; n < dyn->Glyphs.Size; )
+    {
+        ImFontAtlasDynamicGlyph* entry = &dyn->Glyphs[n];
+        if (entry->Shelf != shelf_n)
+        {
+            n++;
+            continue;
+        }
+        ImFont* font = entry->Font;
+        const unsigned int codepoint = font->Glyphs[entry->GlyphIndex].Codepoint;
+        font->IndexLookup[codepoint] = (ImWchar)-1;
+        font->IndexAdvanceX[codepoint] = font->FallbackAdvanceX;
+        font->DynamicGlyphsLastUsed[entry->GlyphIndex - font->DynamicGlyphsStart] = -1;
+        dyn->RequestsState.SetInt(ImFontAtlasDynamicGlyphKey(ImFontAtlasFindFontIndex(atlas, font), codepoint), 0);
+        dyn->Glyphs.erase_unsorted(entry);
+        dyn->EvictedCount++;
+    }
+    dyn->Shelves[shelf_n].X = 0;
+}
+
+// Find room for a w*h rectangle in the dynamic area, evicting shelves if needed. Return the shelf index,
+// -1 if every fitting shelf was used during the last frame (retry on a next update), or -2 if the rectangle is larger than the dynamic area.
+static int ImFontAtlasDynamicGlyphsAllocRect(ImFontAtlas* atlas, int w, int h, int* out_x, int* out_y)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    const int shelf_h = (h + 3) & ~3;
+    if (w > atlas->TexWidth || shelf_h > dyn->AreaY1 - dyn->AreaY0)
+        return -2;
+
+    // Best fitting shelf with enough room left (don't waste more than half of the glyph height)
+    int best_n = -1;
+    for (int n = 0; n < dyn->Shelves.Size; n++)
+    {
+        const ImFontAtlasDynamicShelf& shelf = dyn->Shelves[n];
+        if (shelf.Height >= shelf_h && shelf.Height <= shelf_h + shelf_h / 2 && shelf.X + w <= atlas->TexWidth)
+            if (best_n == -1 || shelf.Height < dyn->Shelves[best_n].Height)
+                best_n = n;
+    }
+
+    // Open a new shelf
+    if (best_n == -1)
+    {
+        const int y = dyn->Shelves.Size ? dyn->Shelves.back().Y + dyn->Shelves.back().Height : dyn->AreaY0;
+        if (y + shelf_h <= dyn->AreaY1)
+        {
+            ImFontAtlasDynamicShelf shelf;
+            shelf.Y = y;
+            shelf.Height = shelf_h;
+            shelf.X = 0;
+            dyn->Shelves.push_back(shelf);
+            best_n = dyn->Shelves.Size - 1;
+        }
+    }
+
+    // Evict the least recently used shelf
+    if (best_n == -1)
+    {
+        ImVector<int> shelves_last_used;
+        shelves_last_used.resize(dyn->Shelves.Size, -1);
+        for (int n = 0; n < dyn->Glyphs.Size; n++)
+        {
+            const ImFontAtlasDynamicGlyph& entry = dyn->Glyphs[n];
+            const int last_used = entry.Font->DynamicGlyphsLastUsed[entry.GlyphIndex - entry.Font->DynamicGlyphsStart];
+            shelves_last_used[entry.Shelf] = ImMax(shelves_last_used[entry.Shelf], last_used);
+        }
+        for (int n = 0; n < dyn->Shelves.Size; n++)
+        {
+            if (dyn->Shelves[n].Height < shelf_h || shelves_last_used[n] >= dyn->FrameCount - 1)
+                continue;
+            if (best_n == -1 || shelves_last_used[n] < shelves_last_used[best_n] || (shelves_last_used[n] == shelves_last_used[best_n] && dyn->Shelves[n].Height < dyn->Shelves[best_n].Height))
+                best_n = n;
+        }
+        if (best_n != -1)
+            ImFontAtlasDynamicGlyphsEvictShelf(atlas, best_n);
+
+        // No shelf is tall enough: remove trailing shelves not used during the last frame to open a taller one
+        int first_n = dyn->Shelves.Size - 1;
+        while (best_n == -1 && first_n >= 0 && shelves_last_used[first_n] < dyn->FrameCount - 1)
+        {
+            if (dyn->Shelves[first_n].Y + shelf_h <= dyn->AreaY1)
+            {
+                for (int n = dyn->Shelves.Size - 1; n >= first_n; n--)
+                    ImFontAtlasDynamicGlyphsEvictShelf(atlas, n);
+                dyn->Shelves[first_n].Height = shelf_h;
+                dyn->Shelves.resize(first_n + 1);
+                best_n = first_n;
+            }
+            first_n--;
+        }
+        if (best_n == -1)
+            return -1;
+    }
+
+    ImFontAtlasDynamicShelf& shelf = dyn->Shelves[best_n];
+    *out_x = shelf.X;
+    *out_y = shelf.Y;
+    shelf.X += w;
+    return best_n;
+}
+
+static bool ImFontAtlasUpdateDynamicGlyphsWithStbTruetype(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    unsigned char* pixels = atlas->TexPixelsAlpha8;
+    if (pixels == NULL)
+        return false;
+
+    bool modified = false;
+    int req_n = 0;
+    for (; req_n < dyn->Requests.Size; req_n++)
+    {
+        ImFont* font = dyn->Requests[req_n].Font;
+        int codepoint = (int)dyn->Requests[req_n].Codepoint;
+        int* state = dyn->RequestsState.GetIntRef(ImFontAtlasDynamicGlyphKey(ImFontAtlasFindFontIndex(atlas, font), (unsigned int)codepoint), 0);
+
+        // Find the first source font providing this codepoint, with the same priority as Build()
+        ImFontConfig* cfg = NULL;
+        stbtt_fontinfo font_info;
+        for (int src_i = 0; src_i < atlas->ConfigData.Size && cfg == NULL; src_i++)
+        {
+            ImFontConfig& src_cfg = atlas->ConfigData[src_i];
+            if (src_cfg.DstFont != font || src_cfg.FontData == NULL)
+                continue;
+            bool in_ranges = false;
+            for (const ImWchar* src_range = src_cfg.GlyphRanges ? src_cfg.GlyphRanges : atlas->GetGlyphRangesDefault(); src_range[0] && src_range[1] && !in_ranges; src_range += 2)
+                in_ranges = (codepoint >= (int)src_range[0] && codepoint <= (int)src_range[1]);
+            if (!in_ranges)
+                continue;
+            const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)src_cfg.FontData, src_cfg.FontNo);
+            if (font_offset >= 0 && stbtt_InitFont(&font_info, (unsigned char*)src_cfg.FontData, font_offset) && stbtt_FindGlyphIndex(&font_info, codepoint) != 0)
+                cfg = &src_cfg;
+        }
+        if (cfg == NULL)
+        {
+            *state = 2;
+            continue;
+        }
+
+        // Measure glyph (same as step 4 of ImFontAtlasBuildWithStbTruetype) and allocate its rectangle
+        const float scale = (cfg->SizePixels > 0) ? stbtt_ScaleForPixelHeight(&font_info, cfg->SizePixels) : stbtt_ScaleForMappingEmToPixels(&font_info, -cfg->SizePixels);
+        int x0, y0, x1, y1;
+        stbtt_GetGlyphBitmapBoxSubpixel(&font_info, stbtt_FindGlyphIndex(&font_info, codepoint), scale * cfg->OversampleH, scale * cfg->OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+        stbrp_rect rect;
+        memset(&rect, 0, sizeof(rect));
+        rect.w = (stbrp_coord)(x1 - x0 + atlas->TexGlyphPadding + cfg->OversampleH - 1);
+        rect.h = (stbrp_coord)(y1 - y0 + atlas->TexGlyphPadding + cfg->OversampleV - 1);
+        int rect_x, rect_y;
+        const int shelf_n = ImFontAtlasDynamicGlyphsAllocRect(atlas, rect.w, rect.h, &rect_x, &rect_y);
+        if (shelf_n == -2)
+        {
+            *state = 2; // Glyph will never fit: render it as the fallback glyph, as if it wasn't found
+            continue;
+        }
+        if (shelf_n == -1)
+            break; // Area is full of glyphs used during the last frame: keep remaining requests for a next update
+        rect.x = (stbrp_coord)rect_x;
+        rect.y = (stbrp_coord)rect_y;
+        rect.was_packed = 1;
+
+        // Clear previous contents, rasterize and apply multiply operator
+        const int dirty_x0 = rect.x, dirty_y0 = rect.y, dirty_x1 = rect.x + rect.w, dirty_y1 = rect.y + rect.h;
+        for (int y = dirty_y0; y < dirty_y1; y++)
+            memset(pixels + dirty_x0 + y * atlas->TexWidth, 0, (size_t)(dirty_x1 - dirty_x0));
+        stbtt_pack_context spc = {};
+        spc.width = atlas->TexWidth;
+        spc.height = atlas->TexHeight;
+        spc.stride_in_bytes = atlas->TexWidth;
+        spc.padding = atlas->TexGlyphPadding;
+        spc.pixels = pixels;
+        stbtt_packedchar pc = {};
+        stbtt_pack_range range = {};
+        range.font_size = cfg->SizePixels;
+        range.array_of_unicode_codepoints = &codepoint;
+        range.num_chars = 1;
+        range.chardata_for_range = &pc;
+        range.h_oversample = (unsigned char)cfg->OversampleH;
+        range.v_oversample = (unsigned char)cfg->OversampleV;
+        stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &range, 1, &rect);
+        if (cfg->RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg->RasterizerMultiply);
+            ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, pixels, rect.x, rect.y, rect.w, rect.h, atlas->TexWidth * 1);
+        }
+        if (atlas->TexPixelsRGBA32)
+            for (int y = dirty_y0; y < dirty_y1; y++)
+                for (int x = dirty_x0; x < dirty_x1; x++)
+                    atlas->TexPixelsRGBA32[x + y * atlas->TexWidth] = IM_COL32(255, 255, 255, (unsigned int)pixels[x + y * atlas->TexWidth]);
+
+        // Register glyph (same as step 9 of ImFontAtlasBuildWithStbTruetype), reusing the slot of an evicted glyph if any
+        stbtt_aligned_quad q;
+        float unused_x = 0.0f, unused_y = 0.0f;
+        stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+        const float font_off_x = cfg->GlyphOffset.x;
+        const float font_off_y = cfg->GlyphOffset.y + IM_ROUND(font->Ascent);
+        font->AddGlyph(cfg, (ImWchar)codepoint, q.x0 + font_off_x, q.y0 + font_off_y, q.x1 + font_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, pc.xadvance);
+        font->DirtyLookupTables = false;
+        int slot_n = (int)(font->DynamicGlyphsLastUsed.find(-1) - font->DynamicGlyphsLastUsed.begin());
+        if (slot_n < font->DynamicGlyphsLastUsed.Size)
+        {
+            font->Glyphs[font->DynamicGlyphsStart + slot_n] = font->Glyphs.back();
+            font->Glyphs.pop_back();
+        }
+        else
+        {
+            font->DynamicGlyphsLastUsed.push_back(-1);
+        }
+        font->DynamicGlyphsLastUsed[slot_n] = dyn->FrameCount;
+        const int glyph_index = font->DynamicGlyphsStart + slot_n;
+        IM_ASSERT(glyph_index < 0xFFFF); // -1 is reserved
+
+        // Update lookup tables (same as ImFont::BuildLookupTable)
+        const int index_size = font->IndexLookup.Size;
+        font->GrowIndex(codepoint + 1);
+        for (int i = index_size; i < font->IndexAdvanceX.Size; i++)
+            font->IndexAdvanceX[i] = font->FallbackAdvanceX;
+        font->IndexAdvanceX[codepoint] = font->Glyphs[glyph_index].AdvanceX;
+        font->IndexLookup[codepoint] = (ImWchar)glyph_index;
+        const int page_n = codepoint / 4096;
+        font->Used4kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+        font->FallbackGlyph = font->FindGlyphNoFallback(font->FallbackChar); // Glyphs[] may have been reallocated
+
+        ImFontAtlasDynamicGlyph entry;
+        entry.Font = font;
+        entry.GlyphIndex = glyph_index;
+        entry.Shelf = shelf_n;
+        dyn->Glyphs.push_back(entry);
+        dyn->RasterizedCount++;
+
+        // Extend dirty rectangle
+        if (atlas->IsTexDirty())
+        {
+            atlas->TexDirtyX0 = ImMin(atlas->TexDirtyX0, dirty_x0);
+            atlas->TexDirtyY0 = ImMin(atlas->TexDirtyY0, dirty_y0);
+            atlas->TexDirtyX1 = ImMax(atlas->TexDirtyX1, dirty_x1);
+            atlas->TexDirtyY1 = ImMax(atlas->TexDirtyY1, dirty_y1);
+        }
+        else
+        {
+            atlas->TexDirtyX0 = dirty_x0;
+            atlas->TexDirtyY0 = dirty_y0;
+            atlas->TexDirtyX1 = dirty_x1;
+            atlas->TexDirtyY1 = dirty_y1;
+        }
+        modified = true;
+    }
+    if (req_n > 0)
+        dyn->Requests.erase(dyn->Requests.Data, dyn->Requests.Data + req_n);
+    return modified;
+}
+
 const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
 {
     static ImFontBuilderIO io;
     io.FontBuilder_Build = ImFontAtlasBuildWithStbTruetype;
+    io.FontBuilder_UpdateDynamicGlyphs = ImFontAtlasUpdateDynamicGlyphsWithStbTruetype;
     return &io;
 }
 
@@ -2801,6 +3906,7 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
             atlas->Fonts[i]->BuildLookupTable();
 
     atlas->TexReady = true;
+    atlas->BuildGeneration++;
 }
 
 // Retrieve list of range (2 int per range, values are inclusive)
@@ -3115,6 +4221,7 @@ ImFont::ImFont()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    DynamicGlyphsStart = INT_MAX;
 }
 
 ImFont::~ImFont()
@@ -3134,6 +4241,8 @@ void    ImFont::ClearOutputData()
     DirtyLookupTables = true;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    DynamicGlyphsStart = INT_MAX;
+    DynamicGlyphsLastUsed.clear();
 }
 
 static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_chars, int candidate_chars_count)
@@ -3306,13 +4415,18 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
 }
 
+// With ImFontAtlasFlags_DynamicGlyphs, a missing glyph is queued to be rasterized by the next ImFontAtlas::UpdateDynamicGlyphs() call.
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = (c < (size_t)IndexLookup.Size) ? IndexLookup.Data[c] : (ImWchar)-1;
     if (i == (ImWchar)-1)
+    {
+        if (ContainerAtlas && ContainerAtlas->DynamicGlyphs)
+            ImFontAtlasRequestDynamicGlyph(ContainerAtlas, this, c);
         return FallbackGlyph;
+    }
+    if ((int)i >= DynamicGlyphsStart) // INT_MAX without dynamic glyphs, so ContainerAtlas->DynamicGlyphs is set here
+        ((ImFont*)this)->DynamicGlyphsLastUsed.Data[i - DynamicGlyphsStart] = ContainerAtlas->DynamicGlyphs->FrameCount;
     return &Glyphs.Data[i];
 }
 
@@ -3425,7 +4539,7 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     return s;
 }
 
-ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
+ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining, ImVector<int>* out_wrap_eols) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
@@ -3450,6 +4564,8 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - line_width);
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
                     word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
+                if (out_wrap_eols)
+                    out_wrap_eols->push_back((int)(word_wrap_eol - text_begin));
             }
 
             if (s >= word_wrap_eol)
@@ -3534,8 +4650,112 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     draw_list->PrimRectUV(ImVec2(pos.x + glyph->X0 * scale, pos.y + glyph->Y0 * scale), ImVec2(pos.x + glyph->X1 * scale, pos.y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
+// Fast path of RenderText() for runs of ASCII and Latin-1 characters, when not clipping on CPU side.
+// Glyphs are resolved and culled into a small buffer first, then their vertices and indices are written in one go.
+#define IM_FONT_RENDER_TEXT_BATCH_SIZE  64
+
+// Indices of 4 quads relative to their first vertex (every quad uses the same pattern, offset by 4 vertices)
+static const ImDrawIdx GFontQuadIndicesPattern[24] = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7, 8, 9, 10, 8, 10, 11, 12, 13, 14, 12, 14, 15 };
+
+// Return the end of the processed run, which is 's' when the first character can't be handled here.
+static const char* ImFontRenderTextRun(const ImFont* font, const char* s, const char* run_end, float* p_x, float y, float scale, const ImVec4& clip_rect, ImU32 col, ImDrawVert** p_vtx_write, ImDrawIdx** p_idx_write, unsigned int* p_vtx_current_idx)
+{
+    // Resolve glyphs. Codepoints below 256 are never dynamic glyphs (see IM_FONT_DYNAMIC_GLYPHS_PRELOAD_LAST) so we can skip FindGlyph() for those present in the font.
+    const ImFontGlyph* glyphs[IM_FONT_RENDER_TEXT_BATCH_SIZE];
+    float glyphs_x[IM_FONT_RENDER_TEXT_BATCH_SIZE];
+    int count = 0;
+    float x = *p_x;
+    while (s < run_end && count < IM_FONT_RENDER_TEXT_BATCH_SIZE)
+    {
+        unsigned int c = (unsigned char)*s;
+        if (c >= 32 && c < 0x80)
+        {
+            s += 1;
+        }
+        else if ((c == 0xC2 || c == 0xC3) && s + 2 <= run_end && (s[1] & 0xC0) == 0x80) // U+0080..U+00FF
+        {
+            c = ((c & 0x1F) << 6) | (s[1] & 0x3F);
+            s += 2;
+        }
+        else
+        {
+            break;
+        }
+        const ImWchar glyph_idx = (c < (unsigned int)font->IndexLookup.Size) ? font->IndexLookup.Data[c] : (ImWchar)-1;
+        const ImFontGlyph* glyph = (glyph_idx < (ImWchar)font->DynamicGlyphsStart) ? &font->Glyphs.Data[glyph_idx] : font->FindGlyph((ImWchar)c);
+        if (glyph == NULL)
+            continue;
+        if (glyph->Visible && x + glyph->X0 * scale <= clip_rect.z && x + glyph->X1 * scale >= clip_rect.x)
+        {
+            glyphs[count] = glyph;
+            glyphs_x[count++] = x;
+        }
+        x += glyph->AdvanceX * scale;
+    }
+    *p_x = x;
+
+    // Write vertices
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    ImDrawVert* vtx_write = *p_vtx_write;
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+    // Corners (X0,Y0,X1,Y1) and texture coordinates (U0,V0,U1,V1) are loaded as one register each, vertices are written as a single 16 bytes store for pos+uv, followed by the color.
+    const __m128 scale4 = _mm_set1_ps(scale);
+    for (int n = 0; n < count; n++, vtx_write += 4)
+    {
+        const ImFontGlyph* glyph = glyphs[n];
+        const __m128 pos = _mm_add_ps(_mm_setr_ps(glyphs_x[n], y, glyphs_x[n], y), _mm_mul_ps(_mm_loadu_ps(&glyph->X0), scale4)); // x1, y1, x2, y2
+        const __m128 uv = _mm_loadu_ps(&glyph->U0);                                                                                 // u1, v1, u2, v2
+        const ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+        _mm_storeu_ps(&vtx_write[0].pos.x, _mm_movelh_ps(pos, uv));                            vtx_write[0].col = glyph_col; // x1, y1, u1, v1
+        _mm_storeu_ps(&vtx_write[1].pos.x, _mm_shuffle_ps(pos, uv, _MM_SHUFFLE(1, 2, 1, 2)));  vtx_write[1].col = glyph_col; // x2, y1, u2, v1
+        _mm_storeu_ps(&vtx_write[2].pos.x, _mm_movehl_ps(uv, pos));                            vtx_write[2].col = glyph_col; // x2, y2, u2, v2
+        _mm_storeu_ps(&vtx_write[3].pos.x, _mm_shuffle_ps(pos, uv, _MM_SHUFFLE(3, 0, 3, 0)));  vtx_write[3].col = glyph_col; // x1, y2, u1, v2
+    }
+#else
+    for (int n = 0; n < count; n++, vtx_write += 4)
+    {
+        const ImFontGlyph* glyph = glyphs[n];
+        const float x1 = glyphs_x[n] + glyph->X0 * scale;
+        const float x2 = glyphs_x[n] + glyph->X1 * scale;
+        const float y1 = y + glyph->Y0 * scale;
+        const float y2 = y + glyph->Y1 * scale;
+        const ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = glyph->U0; vtx_write[0].uv.y = glyph->V0;
+        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = glyph->U1; vtx_write[1].uv.y = glyph->V0;
+        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = glyph->U1; vtx_write[2].uv.y = glyph->V1;
+        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = glyph->U0; vtx_write[3].uv.y = glyph->V1;
+    }
+#endif
+    *p_vtx_write = vtx_write;
+
+    // Write indices: copy the pattern of 4 quads offset by the current vertex index, then finish the remainder
+    ImDrawIdx* idx_write = *p_idx_write;
+    unsigned int vtx_current_idx = *p_vtx_current_idx;
+    int n = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const int idx_per_vec = 16 / (int)sizeof(ImDrawIdx);
+    const int vec_count = 24 / idx_per_vec;
+    for (; n + 4 <= count; n += 4, idx_write += 24, vtx_current_idx += 16)
+    {
+        const __m128i base = (sizeof(ImDrawIdx) == 2) ? _mm_set1_epi16((short)vtx_current_idx) : _mm_set1_epi32((int)vtx_current_idx);
+        for (int v = 0; v < vec_count; v++)
+        {
+            const __m128i pattern = _mm_loadu_si128((const __m128i*)(GFontQuadIndicesPattern + v * idx_per_vec));
+            _mm_storeu_si128((__m128i*)(idx_write + v * idx_per_vec), (sizeof(ImDrawIdx) == 2) ? _mm_add_epi16(pattern, base) : _mm_add_epi32(pattern, base));
+        }
+    }
+#endif
+    for (; n < count; n++, idx_write += 6, vtx_current_idx += 4)
+        for (int i = 0; i < 6; i++)
+            idx_write[i] = (ImDrawIdx)(vtx_current_idx + GFontQuadIndicesPattern[i]);
+    *p_idx_write = idx_write;
+    *p_vtx_current_idx = vtx_current_idx;
+    return s;
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
-void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
+// When 'wrap_eols' is provided, word-wrap positions don't need to be computed again and wrapped lines above the clipping rectangle are skipped.
+void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip, const int* wrap_eols, int wrap_eols_count) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // ImGui:: functions generally already provides a valid text_end, so this is merely to handle direct calls.
@@ -3552,6 +4772,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     const float line_height = FontSize * scale;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
+    int wrap_eols_n = 0;
 
     // Fast-forward to first visible line
     const char* s = text_begin;
@@ -3562,6 +4783,29 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             s = s ? s + 1 : text_end;
             y += line_height;
         }
+    if (y + line_height < clip_rect.y && word_wrap_enabled && wrap_eols != NULL)
+        while (y + line_height < clip_rect.y && s < text_end && (word_wrap_eol != NULL || wrap_eols_n < wrap_eols_count))
+        {
+            // Same steps as the main loop below, line by line
+            if (!word_wrap_eol)
+                word_wrap_eol = text_begin + wrap_eols[wrap_eols_n++];
+            const char* line_end = (s < word_wrap_eol) ? (const char*)memchr(s, '\n', ImMin(word_wrap_eol, text_end) - s) : NULL;
+            y += line_height;
+            if (line_end)
+            {
+                s = line_end + 1;
+                continue;
+            }
+            s = ImMax(s, word_wrap_eol);
+            while (s < text_end && (*s & 0xC0) == 0x80) // Forced wrap within a multi-byte character: the main loop would decode it entirely
+                s++;
+            word_wrap_eol = NULL;
+            while (s < text_end)
+            {
+                const char c = *s;
+                if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+            }
+        }
 
     // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
     // Note that very large horizontal line will still be affected by the issue (e.g. a one megabyte string buffer without a newline will likely crash atm)
@@ -3597,7 +4841,11 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
-            if (!word_wrap_eol)
+            if (!word_wrap_eol && wrap_eols_n < wrap_eols_count)
+            {
+                word_wrap_eol = text_begin + wrap_eols[wrap_eols_n++];
+            }
+            else if (!word_wrap_eol)
             {
                 word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - pos.x));
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
@@ -3608,6 +4856,8 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             {
                 x = pos.x;
                 y += line_height;
+                if (y > clip_rect.w)
+                    break; // break out of main loop
                 word_wrap_eol = NULL;
 
                 // Wrapping skips upcoming blanks
@@ -3620,6 +4870,17 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             }
         }
 
+        // Fast path for runs of ASCII and Latin-1 characters
+        if (!cpu_fine_clip)
+        {
+            const char* run_end = ImFontRenderTextRun(this, s, word_wrap_enabled ? ImMin(word_wrap_eol, text_end) : text_end, &x, y, scale, clip_rect, col, &vtx_write, &idx_write, &vtx_current_idx);
+            if (run_end != s)
+            {
+                s = run_end;
+                continue;
+            }
+        }
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
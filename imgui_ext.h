@@ -10,88 +10,60 @@ static constexpr ImU32 IM_FORCED_COLOR = IM_COL32(255, 130, 40, 255);
 namespace ImGui
 {
 
+// Clips top-level nodes of a tree whose nodes are submitted with their children (so top-level nodes have different heights).
+// Heights of top-level nodes are measured when they are submitted and indexed by ImGuiListClipperHeights, so finding the first
+// visible node after scrolling, and updating the height of a node which was expanded or collapsed, cost O(log N) without a full pass.
+// For very large trees, prefer ImGuiTreeView which doesn't need to submit expanded children.
 struct TreeViewClipper {
     // persist
-    float cursor_end = 0;
-    float cursor_visible_start = 0;
-    uint first_visible_index = 0;
-    float last_scroll = 0;
-    float cursor_visible_end = 0;
-    uint visible_end_index = 0;
-    bool full_pass = true;
+    ImGuiListClipperHeights heights;
+    bool full_pass = false; // set to remeasure all nodes, e.g. after nodes were inserted or removed other than at the end
 
     // valid only between begin end
-    bool scrolled;
-    bool met_visible;
-    bool last_is_visible;
+    float start_y;
+    float node_y;
+    float visible_end_y;
     uint idx;
-    float y;
     bool finished;
     uint count;
 
     // returns index of first visible top-level node
     uint Begin(uint _count) {
         count = _count;
-        scrolled = ImGui::GetScrollY() != last_scroll;
-        if (scrolled) full_pass = true;
         if (full_pass) Refresh();
+        if (heights.DefaultHeight <= 0) heights.DefaultHeight = ImGui::GetTextLineHeightWithSpacing();
+        heights.Resize((int)count);
 
         // skip invisible space
-        ImGui::SetCursorPosY(cursor_visible_start);
+        start_y = ImGui::GetCursorPosY();
+        const float visible_start_y = ImGui::GetScrollY();
+        visible_end_y = visible_start_y + ImGui::GetWindowHeight();
+        idx = (uint)heights.FindItemAtOffset(visible_start_y - start_y);
+        if (idx > 0) ImGui::SetCursorPosY(start_y + heights.GetItemOffset((int)idx));
 
-        // init runtime data
-        met_visible = false;
-        last_is_visible = true;
-        idx = first_visible_index;
         finished = idx >= count;
-                        
         return idx;
     }
 
     void Refresh() {
         full_pass = false;
-        last_scroll = ImGui::GetScrollY();
-        first_visible_index = 0;
-        cursor_visible_start = 0;
-        cursor_end = 0;
+        heights.Clear();
     }
 
     bool BeginNode() {
-        y = ImGui::GetCursorPosY();
+        node_y = ImGui::GetCursorPosY();
         return !finished;
     }
 
     void EndNode() {
-        const bool visible = ImGui::IsItemVisible();
-        const bool is_first_visible = visible && !met_visible;
-        if (is_first_visible) {
-            met_visible = true;
-            first_visible_index = idx;
-            cursor_visible_start = y;
-        }
-        if (met_visible && !visible) {
-            last_is_visible = false;
-            y = ImGui::GetCursorPosY();
-            if (cursor_end != 0) {
-                // something has expended or collapsed
-                if (y != cursor_visible_end && cursor_visible_end != 0) full_pass = true;
-                if (idx != visible_end_index && visible_end_index != 0) full_pass = true;
-                finished = true;
-                cursor_visible_end = y;
-                visible_end_index = idx;
-            }
-        }
+        const float y = ImGui::GetCursorPosY();
+        if (heights.Heights[idx] != y - node_y) heights.SetItemHeight((int)idx, y - node_y);
         ++idx;
-        if (idx == count) finished = true;
+        if (idx == count || y >= visible_end_y) finished = true;
     }
 
     void End() {
-        if (cursor_end == 0 || last_is_visible) {
-            cursor_end = ImGui::GetCursorPosY();
-        }
-        else {
-            ImGui::SetCursorPosY(cursor_end - 2); // TODO why -2
-        }
+        ImGui::SetCursorPosY(start_y + heights.GetTotalHeight());
     }
 };
 
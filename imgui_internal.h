@@ -110,6 +110,8 @@ struct ImBitVector;                 // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImDrawListShapeCache;        // Tessellation cache for repeated shapes, shared between ImDrawList instances
+struct ImDrawListSnapshot;          // Copy of a range of an ImDrawList, replayed by windows using ImGuiWindowFlags_CachedDrawList
 struct ImGuiColorMod;               // Stacked color modifier, backup of modified data so we can restore it
 struct ImGuiContext;                // Main Dear ImGui context
 struct ImGuiContextHook;            // Hook for extensions like ImGuiTestEngine
@@ -135,6 +137,7 @@ struct ImGuiTableColumn;            // Storage for one column of a table
 struct ImGuiTableTempData;          // Temporary storage for one table (one per table in the stack), shared between tables.
 struct ImGuiTableSettings;          // Storage for a table .ini settings
 struct ImGuiTableColumnsSettings;   // Storage for a column .ini settings
+struct ImGuiTextLayoutCache;        // Measured layouts of wrapped text, reused across frames by CalcTextSize() and RenderTextWrapped()
 struct ImGuiWindow;                 // Storage for one window
 struct ImGuiWindowTempData;         // Temporary storage for one window (that's the data which in theory we could ditch at the end of the frame, in practice we currently keep it for each window)
 struct ImGuiWindowSettings;         // Storage for a window .ini settings (we keep one of those even if the actual window wasn't instanced during this session)
@@ -321,6 +324,7 @@ IMGUI_API const char*   ImParseFormatFindEnd(const char* format);
 IMGUI_API const char*   ImParseFormatTrimDecorations(const char* format, char* buf, size_t buf_size);
 IMGUI_API int           ImParseFormatPrecision(const char* format, int default_value);
 static inline bool      ImCharIsBlankA(char c)          { return c == ' ' || c == '\t'; }
+static inline char      ImToLower(char c)               { return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c; }   // ASCII only, independent from the C locale
 static inline bool      ImCharIsBlankW(unsigned int c)  { return c == ' ' || c == '\t' || c == 0x3000; }
 
 // Helpers: UTF-8 <> wchar conversions
@@ -709,11 +713,88 @@ struct IMGUI_API ImDrawListSharedData
     float           ArcFastRadiusCutoff;                        // Cutoff radius after which arc drawing will fallback to slower PathArcTo()
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
     const ImVec4*   TexUvLines;                 // UV of anti-aliased lines in the atlas
+    ImDrawListShapeCache* ShapeCache;           // Tessellation cache used by draw lists with ImDrawListFlags_ShapeCache (optional, owned by ImGuiContext)
+    bool            DisableSSE;                 // [Debug] Take the scalar paths of ImDrawList functions, to compare them with the IMGUI_ENABLE_SSE paths
 
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
 };
 
+// ImDrawList: Maximum number of vertices held by the shape cache before it is flushed.
+#ifndef IM_DRAWLIST_SHAPE_CACHE_MAX_VTX
+#define IM_DRAWLIST_SHAPE_CACHE_MAX_VTX                         (64 * 1024)
+#endif
+
+enum ImDrawListShapeType
+{
+    ImDrawListShapeType_Rect,
+    ImDrawListShapeType_RectFilled,
+    ImDrawListShapeType_Circle,
+    ImDrawListShapeType_CircleFilled
+};
+
+// Parameters identifying a cached tessellation. Positions are not part of it: vertices are stored relative to the shape origin.
+struct ImDrawListShapeKey
+{
+    ImDrawListShapeType Type;
+    ImVec2              Size;                   // Rectangle size or circle radius (in x)
+    float               Rounding;
+    int                 NumSegments;
+    float               Thickness;              // 0.0f for filled shapes
+    ImDrawFlags         Flags;
+    ImDrawListFlags     DrawListFlags;          // Anti-aliasing flags of the draw list
+    float               FringeScale;
+    ImVec2              TexUvWhitePixel;
+    ImVec2              TexUvLines;             // Non-zero when textured lines are used
+    float               CircleSegmentMaxError;  // Tessellation of circles and rounded corners (ArcFastRadiusCutoff and CircleSegmentCounts[] derive from it)
+};
+
+struct ImDrawListShapeCacheEntry
+{
+    ImDrawListShapeKey  Key;
+    int                 VtxOffset;              // Start offset in ImDrawListShapeCache::VtxBuffer
+    int                 VtxCount;
+    int                 IdxOffset;              // Start offset in ImDrawListShapeCache::IdxBuffer
+    int                 IdxCount;
+};
+
+// Tessellation cache for repeated shapes (e.g. same-sized rounded frames or circles drawn every frame).
+// - Vertices are stored relative to the shape origin, 'col' holds a mask applied to the shape color (to emit the transparent AA fringe).
+// - Indices are stored relative to the first vertex of the shape.
+// - When IM_DRAWLIST_SHAPE_CACHE_MAX_VTX is reached, everything is flushed and the cache fills again from scratch.
+struct IMGUI_API ImDrawListShapeCache
+{
+    ImGuiStorage                        Map;            // Key hash -> index + 1 into Entries
+    ImVector<ImDrawListShapeCacheEntry> Entries;
+    ImVector<ImDrawVert>                VtxBuffer;
+    ImVector<ImDrawIdx>                 IdxBuffer;
+    int                                 Hits;           // Stats for the current frame
+    int                                 Misses;
+    int                                 HitsLastFrame;  // Stats for the previous frame (displayed in Metrics window)
+    int                                 MissesLastFrame;
+
+    ImDrawListShapeCache()  { Hits = Misses = HitsLastFrame = MissesLastFrame = 0; }
+    void    Clear()         { Map.Clear(); Entries.clear(); VtxBuffer.clear(); IdxBuffer.clear(); }
+    void    NewFrame()      { HitsLastFrame = Hits; MissesLastFrame = Misses; Hits = Misses = 0; }
+    const ImDrawListShapeCacheEntry* Find(const ImDrawListShapeKey& key, ImGuiID key_hash) const;
+    void    Add(const ImDrawListShapeKey& key, ImGuiID key_hash, const ImDrawVert* vtx, int vtx_count, const ImDrawIdx* idx, int idx_count, unsigned int vtx_base_idx, const ImVec2& origin, ImU32 col);
+};
+
+// Copy of a range of an ImDrawList (commands, indices, vertices) which can be appended again to a draw list on a later frame.
+// - Indices are stored relative to the first vertex of the range, commands IdxOffset relative to the first index of the range.
+// - Used by windows with ImGuiWindowFlags_CachedDrawList to replay their contents without submitting items.
+struct IMGUI_API ImDrawListSnapshot
+{
+    ImVector<ImDrawCmd>     CmdBuffer;
+    ImVector<ImDrawIdx>     IdxBuffer;
+    ImVector<ImDrawVert>    VtxBuffer;
+
+    void    Clear()             { CmdBuffer.resize(0); IdxBuffer.resize(0); VtxBuffer.resize(0); }
+    void    ClearFreeMemory()   { CmdBuffer.clear(); IdxBuffer.clear(); VtxBuffer.clear(); }
+    bool    Capture(const ImDrawList* draw_list, int cmd_start, int idx_start, int vtx_start);
+    bool    Replay(ImDrawList* draw_list) const;
+};
+
 struct ImDrawDataBuilder
 {
     ImVector<ImDrawList*>   Layers[2];           // Global layers for: regular, tooltip
@@ -1054,6 +1135,8 @@ struct IMGUI_API ImGuiInputTextState
     ImVector<ImWchar>       TextW;                  // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer.
     ImVector<char>          TextA;                  // temporary UTF8 buffer for callbacks and other operations. this is not updated in every code-path! size=capacity.
     ImVector<char>          InitialTextA;           // backup of end-user buffer at the time of focus (in UTF-8, unaltered)
+    ImVector<int>           LineStartsW;            // offset of the first character of each line in TextW. kept up to date by STB_TEXTEDIT_INSERTCHARS/STB_TEXTEDIT_DELETECHARS so rows are found with a binary search instead of scanning the text.
+    ImVector<int>           LineStartsA;            // offset of the first character of each line in UTF-8 (TextA), same indices as LineStartsW.
     bool                    TextAIsValid;           // temporary UTF8 buffer is not initially valid before we make the widget active (until then we pull the data from user argument)
     int                     BufCapacityA;           // end-user buffer capacity
     float                   ScrollX;                // horizontal scrolling/offset
@@ -1067,12 +1150,16 @@ struct IMGUI_API ImGuiInputTextState
     void*                   UserCallbackData;       // "
 
     ImGuiInputTextState()                   { memset(this, 0, sizeof(*this)); }
-    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); }
+    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; LineStartsW.resize(1); LineStartsA.resize(1); LineStartsW[0] = LineStartsA[0] = 0; CursorClamp(); }
+    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); LineStartsW.clear(); LineStartsA.clear(); }
     int         GetUndoAvailCount() const   { return Stb.undostate.undo_point; }
     int         GetRedoAvailCount() const   { return STB_TEXTEDIT_UNDOSTATECOUNT - Stb.undostate.redo_point; }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
 
+    // Line index
+    void        RebuildLineIndex();         // Rebuild LineStartsW/LineStartsA after TextW has been replaced as a whole
+    int         GetLineFromPos(int pos) const; // Index of the line containing character 'pos' of TextW
+
     // Cursor & Selection
     void        CursorAnimReset()           { CursorAnim = -0.30f; }                                   // After a user-input the cursor stays on for a while without blinking
     void        CursorClamp()               { Stb.cursor = ImMin(Stb.cursor, CurLenW); Stb.select_start = ImMin(Stb.select_start, CurLenW); Stb.select_end = ImMin(Stb.select_end, CurLenW); }
@@ -1182,6 +1269,52 @@ struct ImGuiPtrOrIndex
     ImGuiPtrOrIndex(int index)  { Ptr = NULL; Index = index; }
 };
 
+// Entries not used for that many frames are evicted from the text layout cache
+#define IMGUI_TEXT_LAYOUT_CACHE_MAX_AGE     2
+
+struct ImGuiTextLayoutCacheEntry
+{
+    ImGuiID                 KeyHash;
+    ImFont*                 Font;
+    float                   FontSize;
+    float                   WrapWidth;
+    int                     TextOffset;         // Copy of the text in ImGuiTextLayoutCache::TextBuffer, compared on lookup
+    int                     TextLen;
+    int                     WrapEolsOffset;     // Word-wrap line ends in ImGuiTextLayoutCache::WrapEols, as output by ImFont::CalcTextSizeA()
+    int                     WrapEolsCount;
+    ImVec2                  Size;               // Unrounded size output by ImFont::CalcTextSizeA()
+    int                     LastFrameUsed;
+};
+
+// Measured layouts of wrapped text, reused across frames by CalcTextSize() and RenderTextWrapped() (see io.ConfigTextLayoutCache)
+// - Keyed by font, font size, wrap width and text contents (a copy of the text is kept, so a hash collision can't return a wrong layout).
+// - Not used for unwrapped text: hashing and comparing it costs about as much as measuring it again.
+// - NewFrame() evicts entries unused for IMGUI_TEXT_LAYOUT_CACHE_MAX_AGE frames, and clears everything when the font atlas BuildGeneration changes.
+struct IMGUI_API ImGuiTextLayoutCache
+{
+    ImGuiStorage                        Map;            // Key hash -> index + 1 into Entries (hash indexed)
+    ImVector<ImGuiTextLayoutCacheEntry> Entries;
+    ImVector<char>                      TextBuffer;
+    ImVector<int>                       WrapEols;
+    const ImFontAtlas*                  Atlas;          // Font atlas and generation the entries were measured with
+    int                                 AtlasBuildGeneration;
+    int                                 Hits;           // Stats for the current frame
+    int                                 Misses;
+    int                                 HitsLastFrame;  // Stats for the previous frame (displayed in Metrics window)
+    int                                 MissesLastFrame;
+
+    ImGuiTextLayoutCache()  { Map.SetUseHashIndex(true); Atlas = NULL; AtlasBuildGeneration = 0; Hits = Misses = HitsLastFrame = MissesLastFrame = 0; }
+    void    Clear()         { Map.Clear(); Entries.clear(); TextBuffer.clear(); WrapEols.clear(); }
+    void    NewFrame(const ImFontAtlas* atlas, int frame_count);
+    ImGuiTextLayoutCacheEntry*  Find(ImGuiID key_hash, ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end);
+    ImGuiTextLayoutCacheEntry*  Add(ImGuiID key_hash, ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end);
+};
+
+// Amount of new text measured per frame by TextUnformattedIndexed() (see ImGuiTextIndex). Lines not measured yet count as a single row of zero width.
+#ifndef IMGUI_TEXT_INDEX_LAYOUT_BYTES_PER_FRAME
+#define IMGUI_TEXT_INDEX_LAYOUT_BYTES_PER_FRAME     (1 << 20)
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Columns support
 //-----------------------------------------------------------------------------
@@ -1393,6 +1526,10 @@ struct ImGuiContext
     float                   FontSize;                           // (Shortcut) == FontBaseSize * g.CurrentWindow->FontWindowScale == window->FontSize(). Text height for current window.
     float                   FontBaseSize;                       // (Shortcut) == IO.FontGlobalScale * Font->Scale * Font->FontSize. Base text height.
     ImDrawListSharedData    DrawListSharedData;
+    ImDrawListShapeCache    DrawListShapeCache;
+    ImVector<ImDrawListSharedData*> DeferredDrawListsSharedData;  // Copies of DrawListSharedData used by deferred draw lists (see AddDeferredDrawList()), reused every frame
+    int                     DeferredDrawListsSharedDataUsed;
+    ImGuiTextLayoutCache    TextLayoutCache;                    // Measured text layouts (when io.ConfigTextLayoutCache is enabled)
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -1637,6 +1774,8 @@ struct ImGuiContext
         Font = NULL;
         FontSize = FontBaseSize = 0.0f;
         IO.Fonts = shared_font_atlas ? shared_font_atlas : IM_NEW(ImFontAtlas)();
+        DrawListSharedData.ShapeCache = &DrawListShapeCache;
+        DeferredDrawListsSharedDataUsed = 0;
         Time = 0.0f;
         FrameCount = 0;
         FrameCountEnded = FrameCountRendered = -1;
@@ -1822,6 +1961,7 @@ struct IMGUI_API ImGuiWindowTempData
     int                     TreeDepth;              // Current tree depth.
     ImU32                   TreeJumpToParentOnPopMask; // Store a copy of !g.NavIdIsAlive for TreeDepth 0..31.. Could be turned into a ImU64 if necessary.
     ImVector<ImGuiWindow*>  ChildWindows;
+    ImVector<ImDrawList*>   DeferredDrawLists;      // Draw lists built by the user (possibly on other threads), rendered after DrawList. See AddDeferredDrawList().
     ImGuiStorage*           StateStorage;           // Current persistent per-window storage (store e.g. tree node open/close state)
     ImGuiOldColumns*        CurrentColumns;         // Current columns set
     int                     CurrentTableIdx;        // Current table index (into g.Tables)
@@ -1932,6 +2072,13 @@ struct IMGUI_API ImGuiWindow
     int                     MemoryDrawListVtxCapacity;
     bool                    MemoryCompacted;                    // Set when window extraneous data have been garbage collected
 
+    ImDrawListSnapshot      DrawListCache;                      // Contents recorded for ImGuiWindowFlags_CachedDrawList
+    ImGuiID                 DrawListCacheSignature;             // Hash of the state DrawListCache was recorded with. 0 when DrawListCache is invalid.
+    int                     DrawListCacheRecordCmd;             // Offsets into DrawList where recording started on this frame (-1 when not recording)
+    int                     DrawListCacheRecordIdx;
+    int                     DrawListCacheRecordVtx;
+    bool                    DrawListCacheReplayed;              // Contents were replayed from DrawListCache on this frame (items were skipped)
+
 public:
     ImGuiWindow(ImGuiContext* context, const char* name);
     ~ImGuiWindow();
@@ -2326,6 +2473,7 @@ namespace ImGui
     IMGUI_API void          SetWindowSize(ImGuiWindow* window, const ImVec2& size, ImGuiCond cond = 0);
     IMGUI_API void          SetWindowCollapsed(ImGuiWindow* window, bool collapsed, ImGuiCond cond = 0);
     IMGUI_API void          SetWindowHitTestHole(ImGuiWindow* window, const ImVec2& pos, const ImVec2& size);
+    IMGUI_API void          MarkWindowDrawListDirty(ImGuiWindow* window);
 
     // Windows: Display Order and Focus Order
     IMGUI_API void          FocusWindow(ImGuiWindow* window);
@@ -2684,6 +2832,43 @@ namespace ImGui
 struct ImFontBuilderIO
 {
     bool    (*FontBuilder_Build)(ImFontAtlas* atlas);
+    bool    (*FontBuilder_UpdateDynamicGlyphs)(ImFontAtlas* atlas);     // Optional: rasterize glyphs queued in atlas->DynamicGlyphs. Return true if the texture was modified.
+};
+
+// Storage for ImFontAtlasFlags_DynamicGlyphs
+// Glyphs are packed in shelves (rows of a same rounded height) within the texture area [AreaY0, AreaY1).
+// When the area is full, the least recently used shelf which wasn't used during the last frame is evicted as a whole.
+struct ImFontAtlasDynamicShelf
+{
+    int     Y, Height;          // Position and height of the row in the texture
+    int     X;                  // Next free x position in the row
+};
+
+struct ImFontAtlasDynamicGlyph
+{
+    ImFont* Font;
+    int     GlyphIndex;         // Index into Font->Glyphs[]
+    int     Shelf;              // Index into ImFontAtlasDynamicGlyphs::Shelves[]
+};
+
+struct ImFontAtlasDynamicRequest
+{
+    ImFont* Font;
+    ImWchar Codepoint;
+};
+
+struct IMGUI_API ImFontAtlasDynamicGlyphs
+{
+    int                                 FrameCount;         // Incremented by each UpdateDynamicGlyphs() call, used to timestamp glyphs usage.
+    int                                 AreaY0, AreaY1;     // Texture rows reserved for dynamic glyphs
+    ImVector<ImFontAtlasDynamicShelf>   Shelves;
+    ImVector<ImFontAtlasDynamicGlyph>   Glyphs;             // Glyphs currently in the texture
+    ImVector<ImFontAtlasDynamicRequest> Requests;           // Glyphs missed since last update
+    ImGuiStorage                        RequestsState;      // Key = font index << 21 | codepoint. 1 = queued or rasterized, 2 = not found in any source font, or larger than the dynamic area.
+    int                                 RasterizedCount;    // Statistics
+    int                                 EvictedCount;
+
+    ImFontAtlasDynamicGlyphs()          { FrameCount = 0; AreaY0 = AreaY1 = 0; RasterizedCount = EvictedCount = 0; }
 };
 
 // Helper for font builder
@@ -2696,6 +2881,7 @@ IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas,
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+IMGUI_API void      ImFontAtlasRequestDynamicGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c);
 
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
@@ -14,6 +14,7 @@ Index of this file:
 // [SECTION] Tables: Columns width management
 // [SECTION] Tables: Drawing
 // [SECTION] Tables: Sorting
+// [SECTION] Tables: Data source
 // [SECTION] Tables: Headers
 // [SECTION] Tables: Context Menu
 // [SECTION] Tables: Settings (.ini data)
@@ -2252,8 +2253,17 @@ void ImGui::TablePopBackgroundChannel()
 // Where D is 1 if any column is clipped or hidden (dummy channel) otherwise 0.
 void ImGui::TableSetupDrawChannels(ImGuiTable* table)
 {
+    // Columns clipped by scrolling share the dummy channel, so only visible columns need their own channels.
+    // (this matters with wide tables, where most enabled columns are generally scrolled out of view)
+    int channels_for_row = 1;
+    if (!(table->Flags & ImGuiTableFlags_NoClip))
+    {
+        channels_for_row = 0;
+        for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
+            if (table->VisibleMaskByIndex & ((ImU64)1 << column_n))
+                channels_for_row++;
+    }
     const int freeze_row_multiplier = (table->FreezeRowsCount > 0) ? 2 : 1;
-    const int channels_for_row = (table->Flags & ImGuiTableFlags_NoClip) ? 1 : table->ColumnsEnabledCount;
     const int channels_for_bg = 1 + 1 * freeze_row_multiplier;
     const int channels_for_dummy = (table->ColumnsEnabledCount < table->ColumnsCount || table->VisibleMaskByIndex != table->EnabledMaskByIndex) ? +1 : 0;
     const int channels_total = channels_for_bg + (channels_for_row * freeze_row_multiplier) + channels_for_dummy;
@@ -2411,8 +2421,26 @@ void ImGui::TableMergeDrawChannels(ImGuiTable* table)
     {
         // We skip channel 0 (Bg0/Bg1) and 1 (Bg2 frozen) from the shuffling since they won't move - see channels allocation in TableSetupDrawChannels().
         const int LEADING_DRAW_CHANNELS = 2;
-        g.DrawChannelsTempMergeBuffer.resize(splitter->_Count - LEADING_DRAW_CHANNELS); // Use shared temporary storage so the allocation gets amortized
-        ImDrawChannel* dst_tmp = g.DrawChannelsTempMergeBuffer.Data;
+
+        // When a single group holds all the leading column channels (common case: no frozen rows, every visible column fitting
+        // in its clip rectangle), the reordered list would be identical to the current one: only rewrite the clip rectangles.
+        bool reorder_channels = true;
+        if (!has_freeze_v && ImIsPowerOfTwo((ImU64)merge_group_mask))
+            for (int merge_group_n = 0; merge_group_n < IM_ARRAYSIZE(merge_groups); merge_group_n++)
+                if (merge_group_mask & (1 << merge_group_n))
+                {
+                    MergeGroup* merge_group = &merge_groups[merge_group_n];
+                    reorder_channels = false;
+                    for (int n = LEADING_DRAW_CHANNELS; n < LEADING_DRAW_CHANNELS + merge_group->ChannelsCount && !reorder_channels; n++)
+                        reorder_channels = !merge_group->ChannelsMask.TestBit(n);
+                }
+
+        ImDrawChannel* dst_tmp = NULL;
+        if (reorder_channels)
+        {
+            g.DrawChannelsTempMergeBuffer.resize(splitter->_Count - LEADING_DRAW_CHANNELS); // Use shared temporary storage so the allocation gets amortized
+            dst_tmp = g.DrawChannelsTempMergeBuffer.Data;
+        }
         ImBitArray<IMGUI_TABLE_MAX_DRAW_CHANNELS> remaining_mask;                       // We need 132-bit of storage
         remaining_mask.SetBitRange(LEADING_DRAW_CHANNELS, splitter->_Count);
         remaining_mask.ClearBit(table->Bg2DrawChannelUnfrozen);
@@ -2461,7 +2489,8 @@ void ImGui::TableMergeDrawChannels(ImGuiTable* table)
                     ImDrawChannel* channel = &splitter->_Channels[n];
                     IM_ASSERT(channel->_CmdBuffer.Size == 1 && merge_clip_rect.Contains(ImRect(channel->_CmdBuffer[0].ClipRect)));
                     channel->_CmdBuffer[0].ClipRect = merge_clip_rect.ToVec4();
-                    memcpy(dst_tmp++, channel, sizeof(ImDrawChannel));
+                    if (reorder_channels)
+                        memcpy(dst_tmp++, channel, sizeof(ImDrawChannel));
                 }
             }
 
@@ -2470,6 +2499,9 @@ void ImGui::TableMergeDrawChannels(ImGuiTable* table)
                 memcpy(dst_tmp++, &splitter->_Channels[table->Bg2DrawChannelUnfrozen], sizeof(ImDrawChannel));
         }
 
+        if (!reorder_channels)
+            return;
+
         // Append unmergeable channels that we didn't reorder at the end of the list
         for (int n = 0; n < splitter->_Count && remaining_count != 0; n++)
         {
@@ -2776,6 +2808,299 @@ void ImGui::TableSortSpecsBuild(ImGuiTable* table)
     table->SortSpecs.SpecsCount = table->SortSpecsCount;
 }
 
+//-------------------------------------------------------------------------
+// [SECTION] Tables: Data source
+//-------------------------------------------------------------------------
+// - ImGuiTableDataSource
+// - TableDataSourceCompareRows() [Internal]
+// - TableDataSourceMergeRows() [Internal]
+// - TableDataSourceSortRows() [Internal]
+// - TableDataSourceRows()
+//-------------------------------------------------------------------------
+
+static const int TABLE_DATA_SOURCE_ROWS_PER_TASK_MIN = 16384;    // Full sorts are split in tasks for ImGuiTableDataSource::SortParallelForFn only above this number of rows per task.
+static const int TABLE_DATA_SOURCE_TASKS_MAX = 64;
+
+ImGuiTableDataSource::ImGuiTableDataSource()
+{
+    UserData = NULL;
+    CellFn = NULL;
+    SortParallelForFn = NULL;
+    SortParallelForUserData = NULL;
+    RowsCount = 0;
+    SortedRowsValid = false;
+}
+
+void ImGuiTableDataSource::SetRowsCount(int rows_count)
+{
+    IM_ASSERT(rows_count >= 0);
+    if (SortedRowsValid && rows_count > RowsCount)
+    {
+        if (rows_count - RowsCount > RowsCount / 4)
+            SortedRowsValid = false; // Cheaper to sort everything again
+        else
+            for (int row = RowsCount; row < rows_count; row++)
+                DirtyRows.push_back(row);
+    }
+    else if (rows_count < RowsCount)
+    {
+        int dirty_count = 0;
+        for (int n = 0; n < DirtyRows.Size; n++)
+            if (DirtyRows[n] < rows_count)
+                DirtyRows[dirty_count++] = DirtyRows[n];
+        DirtyRows.resize(dirty_count);
+    }
+    RowsCount = rows_count; // Removed rows are dropped from SortedRows by the next Sort()
+}
+
+void ImGuiTableDataSource::SetColumnCompareFn(int column_n, ImGuiTableRowCompareFunc compare_fn)
+{
+    IM_ASSERT(column_n >= 0 && column_n < IMGUI_TABLE_MAX_COLUMNS);
+    if (column_n >= ColumnCompareFns.Size)
+        ColumnCompareFns.resize(column_n + 1, NULL);
+    if (ColumnCompareFns[column_n] != compare_fn)
+        SortedRowsValid = false;
+    ColumnCompareFns[column_n] = compare_fn;
+}
+
+// Rows which compare equal on every sorted column are ordered by index, so the order is total and every sort is stable.
+static int TableDataSourceCompareRows(const ImGuiTableDataSource* source, int row_a, int row_b)
+{
+    for (const ImGuiTableColumnSortSpecs* sort_spec = source->SortSpecs.begin(); sort_spec != source->SortSpecs.end(); sort_spec++)
+    {
+        ImGuiTableRowCompareFunc compare_fn = (sort_spec->ColumnIndex < source->ColumnCompareFns.Size) ? source->ColumnCompareFns[sort_spec->ColumnIndex] : NULL;
+        if (compare_fn == NULL)
+            continue;
+        const int delta = compare_fn(source->UserData, row_a, row_b);
+        if (delta != 0)
+            return ((delta > 0) == (sort_spec->SortDirection == ImGuiSortDirection_Ascending)) ? +1 : -1;
+    }
+    return row_a - row_b;
+}
+
+static void TableDataSourceMergeRows(const ImGuiTableDataSource* source, const int* rows_a, int rows_a_count, const int* rows_b, int rows_b_count, int* out)
+{
+    const int* rows_a_end = rows_a + rows_a_count;
+    const int* rows_b_end = rows_b + rows_b_count;
+    while (rows_a < rows_a_end && rows_b < rows_b_end)
+        *out++ = (TableDataSourceCompareRows(source, *rows_b, *rows_a) < 0) ? *rows_b++ : *rows_a++;
+    if (rows_a < rows_a_end)
+        memcpy(out, rows_a, (size_t)(rows_a_end - rows_a) * sizeof(int));
+    if (rows_b < rows_b_end)
+        memcpy(out, rows_b, (size_t)(rows_b_end - rows_b) * sizeof(int));
+}
+
+// Bottom-up merge sort, using 'temp' (same size as 'rows') as scratch.
+static void TableDataSourceSortRows(const ImGuiTableDataSource* source, int* rows, int* temp, int rows_count)
+{
+    const int RUN_SIZE = 16;
+    for (int run_start = 0; run_start < rows_count; run_start += RUN_SIZE)
+    {
+        const int run_end = ImMin(run_start + RUN_SIZE, rows_count);
+        for (int n = run_start + 1; n < run_end; n++)
+        {
+            const int row = rows[n];
+            int dst_n = n;
+            for (; dst_n > run_start && TableDataSourceCompareRows(source, rows[dst_n - 1], row) > 0; dst_n--)
+                rows[dst_n] = rows[dst_n - 1];
+            rows[dst_n] = row;
+        }
+    }
+
+    int* src = rows;
+    int* dst = temp;
+    for (int width = RUN_SIZE; width < rows_count; width *= 2)
+    {
+        for (int start = 0; start < rows_count; start += width * 2)
+        {
+            const int mid = ImMin(start + width, rows_count);
+            const int end = ImMin(start + width * 2, rows_count);
+            TableDataSourceMergeRows(source, src + start, mid - start, src + mid, end - mid, dst + start);
+        }
+        ImSwap(src, dst);
+    }
+    if (src != rows)
+        memcpy(rows, src, (size_t)rows_count * sizeof(int));
+}
+
+// Full sorts with ImGuiTableDataSource::SortParallelForFn: each task sorts one chunk of rows, then chunks are merged
+// two by two (one task per pair) until one remains.
+struct ImGuiTableDataSourceSortTasks
+{
+    const ImGuiTableDataSource* Source;
+    int*    Rows;
+    int*    Temp;
+    int     RowsCount;
+    int     ChunksCount;
+    int     MergeWidth;     // In chunks
+
+    int     GetChunkStart(int chunk_n) const { return (int)((ImS64)RowsCount * ImMin(chunk_n, ChunksCount) / ChunksCount); }
+};
+
+static void TableDataSourceSortChunkTask(void* task_data, int task_n)
+{
+    ImGuiTableDataSourceSortTasks* tasks = (ImGuiTableDataSourceSortTasks*)task_data;
+    const int start = tasks->GetChunkStart(task_n);
+    TableDataSourceSortRows(tasks->Source, tasks->Rows + start, tasks->Temp + start, tasks->GetChunkStart(task_n + 1) - start);
+}
+
+static void TableDataSourceMergeChunksTask(void* task_data, int task_n)
+{
+    ImGuiTableDataSourceSortTasks* tasks = (ImGuiTableDataSourceSortTasks*)task_data;
+    const int chunk_n = task_n * tasks->MergeWidth * 2;
+    const int start = tasks->GetChunkStart(chunk_n);
+    const int mid = tasks->GetChunkStart(chunk_n + tasks->MergeWidth);
+    const int end = tasks->GetChunkStart(chunk_n + tasks->MergeWidth * 2);
+    TableDataSourceMergeRows(tasks->Source, tasks->Rows + start, mid - start, tasks->Rows + mid, end - mid, tasks->Temp + start);
+}
+
+// Sort if sort specs changed or rows were invalidated.
+// - Full sort: O(N log N), split in tasks when SortParallelForFn is set.
+// - Otherwise: invalidated rows are removed from SortedRows, sorted, then inserted back: O(N) copies + O(D log N) compares.
+void ImGuiTableDataSource::Sort(ImGuiTableSortSpecs* sort_specs)
+{
+    const int specs_count = sort_specs ? sort_specs->SpecsCount : 0;
+    bool specs_changed = (specs_count != SortSpecs.Size);
+    for (int n = 0; n < specs_count && !specs_changed; n++)
+        specs_changed = (sort_specs->Specs[n].ColumnIndex != SortSpecs[n].ColumnIndex || sort_specs->Specs[n].SortDirection != SortSpecs[n].SortDirection);
+    if (sort_specs)
+        sort_specs->SpecsDirty = false;
+    if (specs_changed)
+    {
+        SortSpecs.resize(specs_count);
+        if (specs_count > 0)
+            memcpy(SortSpecs.Data, sort_specs->Specs, (size_t)specs_count * sizeof(ImGuiTableColumnSortSpecs));
+        SortedRowsValid = false;
+    }
+
+    if (!SortedRowsValid || DirtyRows.Size > RowsCount / 4)
+    {
+        SortedRows.resize(RowsCount);
+        TempRows.resize(RowsCount);
+        for (int row = 0; row < RowsCount; row++)
+            SortedRows[row] = row;
+        DirtyRows.resize(0);
+        SortedRowsValid = true;
+
+        bool has_compare_fn = false;
+        for (int n = 0; n < SortSpecs.Size && !has_compare_fn; n++)
+            has_compare_fn = (SortSpecs[n].ColumnIndex < ColumnCompareFns.Size && ColumnCompareFns[SortSpecs[n].ColumnIndex] != NULL);
+        if (!has_compare_fn)
+            return; // Unsorted: rows are displayed in index order
+
+        int tasks_count = 1;
+        while (SortParallelForFn != NULL && tasks_count < TABLE_DATA_SOURCE_TASKS_MAX && RowsCount / (tasks_count * 2) >= TABLE_DATA_SOURCE_ROWS_PER_TASK_MIN)
+            tasks_count *= 2;
+        if (tasks_count == 1)
+        {
+            TableDataSourceSortRows(this, SortedRows.Data, TempRows.Data, RowsCount);
+            return;
+        }
+
+        ImGuiTableDataSourceSortTasks tasks;
+        tasks.Source = this;
+        tasks.Rows = SortedRows.Data;
+        tasks.Temp = TempRows.Data;
+        tasks.RowsCount = RowsCount;
+        tasks.ChunksCount = tasks_count;
+        tasks.MergeWidth = 0;
+        SortParallelForFn(SortParallelForUserData, tasks_count, TableDataSourceSortChunkTask, &tasks);
+        for (tasks.MergeWidth = 1; tasks.MergeWidth < tasks_count; tasks.MergeWidth *= 2)
+        {
+            SortParallelForFn(SortParallelForUserData, tasks_count / (tasks.MergeWidth * 2), TableDataSourceMergeChunksTask, &tasks);
+            ImSwap(tasks.Rows, tasks.Temp);
+        }
+        if (tasks.Rows != SortedRows.Data)
+            SortedRows.swap(TempRows);
+        return;
+    }
+
+    if (DirtyRows.Size == 0 && SortedRows.Size == RowsCount)
+        return;
+
+    // Remove invalidated rows (and rows past RowsCount) from SortedRows
+    TempRowsMask.resize((RowsCount + 31) >> 5, 0);
+    for (int n = 0; n < DirtyRows.Size; n++)
+    {
+        IM_ASSERT(DirtyRows[n] < RowsCount && "InvalidateRow() called with a row index out of range!");
+        TempRowsMask[DirtyRows[n] >> 5] |= (ImU32)1 << (DirtyRows[n] & 31);
+    }
+    int sorted_count = 0;
+    for (int n = 0; n < SortedRows.Size; n++)
+    {
+        const int row = SortedRows[n];
+        if (row < RowsCount && (TempRowsMask[row >> 5] & ((ImU32)1 << (row & 31))) == 0)
+            SortedRows[sorted_count++] = row;
+    }
+    SortedRows.resize(sorted_count);
+
+    // Remove duplicates from DirtyRows, clearing the mask for the next call
+    int dirty_count = 0;
+    for (int n = 0; n < DirtyRows.Size; n++)
+    {
+        const int row = DirtyRows[n];
+        if ((TempRowsMask[row >> 5] & ((ImU32)1 << (row & 31))) != 0)
+        {
+            TempRowsMask[row >> 5] &= ~((ImU32)1 << (row & 31));
+            DirtyRows[dirty_count++] = row;
+        }
+    }
+    DirtyRows.resize(dirty_count);
+
+    // Sort invalidated rows and insert them back. Binary searches keep compare calls to O(D log N), the rest is copying.
+    TempRows.resize(ImMax(dirty_count, RowsCount));
+    TableDataSourceSortRows(this, DirtyRows.Data, TempRows.Data, dirty_count);
+    int* out = TempRows.Data;
+    int src_n = 0;
+    for (int n = 0; n < dirty_count; n++)
+    {
+        const int row = DirtyRows[n];
+        int lo = src_n, hi = sorted_count;
+        while (lo < hi)
+        {
+            const int mid = lo + ((hi - lo) >> 1);
+            if (TableDataSourceCompareRows(this, SortedRows[mid], row) < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        memcpy(out, SortedRows.Data + src_n, (size_t)(lo - src_n) * sizeof(int));
+        out += lo - src_n;
+        *out++ = row;
+        src_n = lo;
+    }
+    memcpy(out, SortedRows.Data + src_n, (size_t)(sorted_count - src_n) * sizeof(int));
+    TempRows.resize(sorted_count + dirty_count);
+    SortedRows.swap(TempRows);
+    DirtyRows.resize(0);
+    IM_ASSERT(SortedRows.Size == RowsCount);
+}
+
+// Call after TableSetupColumn() and TableHeadersRow(), in place of submitting rows yourself.
+void ImGui::TableDataSourceRows(ImGuiTableDataSource* source, float row_min_height)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    IM_ASSERT(table != NULL && "Need to call TableDataSourceRows() after BeginTable()!");
+    IM_ASSERT(source->CellFn != NULL);
+
+    source->Sort(TableGetSortSpecs());
+
+    ImGuiListClipper clipper;
+    clipper.Begin(source->SortedRows.Size);
+    while (clipper.Step())
+        for (int display_n = clipper.DisplayStart; display_n < clipper.DisplayEnd; display_n++)
+        {
+            const int row = source->SortedRows[display_n];
+            TableNextRow(ImGuiTableRowFlags_None, row_min_height);
+            PushID(row);
+            for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
+                if (TableSetColumnIndex(column_n) || column_n == 0) // Always submit the first column so the row has a height
+                    source->CellFn(source->UserData, row, column_n);
+            PopID();
+        }
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Tables: Headers
 //-------------------------------------------------------------------------
@@ -128,11 +128,16 @@ static bool             InputTextFilterCharacter(unsigned int* p_char, ImGuiInpu
 static int              InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end);
 static ImVec2           InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining = NULL, ImVec2* out_offset = NULL, bool stop_on_new_line = false);
 
+// For TextUnformattedIndexed()
+static int              TextIndexGetLineRow(const ImGuiTextIndex* index, int line_no);
+static int              TextIndexFindLineAtRow(const ImGuiTextIndex* index, int row);
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Text, etc.
 //-------------------------------------------------------------------------
 // - TextEx() [Internal]
 // - TextUnformatted()
+// - TextUnformattedIndexed()
 // - Text()
 // - TextV()
 // - TextColored()
@@ -255,6 +260,163 @@ void ImGui::TextUnformatted(const char* text, const char* text_end)
     TextEx(text, text_end, ImGuiTextFlags_NoWidthForLargeClippedText);
 }
 
+// First visual row of a line. Lines past the measured ones count as a single row.
+static int TextIndexGetLineRow(const ImGuiTextIndex* index, int line_no)
+{
+    const ImVector<int>& rows_end = index->LayoutRowsEnd;
+    if (rows_end.Size == 0)
+        return line_no;
+    if (line_no <= rows_end.Size)
+        return (line_no == 0) ? 0 : rows_end[line_no - 1];
+    return rows_end.back() + (line_no - rows_end.Size);
+}
+
+// Line covering a visual row: binary search over the cumulative row counts of measured lines.
+static int TextIndexFindLineAtRow(const ImGuiTextIndex* index, int row)
+{
+    const ImVector<int>& rows_end = index->LayoutRowsEnd;
+    if (rows_end.Size == 0)
+        return row;
+    if (row >= rows_end.back())
+        return rows_end.Size + (row - rows_end.back());
+    int lo = 0, hi = rows_end.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (rows_end[mid] > row)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return lo;
+}
+
+// Huge text display using a persistent line index.
+// - Unlike the "long text" path of TextEx() which scans the text from its beginning every frame, only visible lines are processed.
+//   The first visible line is found in O(1), or in O(log N) when word-wrapping (binary search over the cached row counts).
+// - Without word-wrapping, lines are also clipped horizontally: characters outside of the clipping rectangle are not submitted.
+// - Line widths and word-wrapped row counts are cached in the index. New lines are measured as they are appended, at most
+//   IMGUI_TEXT_INDEX_LAYOUT_BYTES_PER_FRAME per frame, so that indexing a huge text doesn't stall a single frame.
+void ImGui::TextUnformattedIndexed(const char* text, ImGuiTextIndex* index)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(text != NULL && index != NULL);
+    ImFont* font = g.Font;
+    const float line_height = g.FontSize;
+    const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
+    const float wrap_pos_x = window->DC.TextWrapPos;
+    const bool wrap_enabled = (wrap_pos_x >= 0.0f);
+    const float wrap_width = wrap_enabled ? ImMax(CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x), 1.0f) : 0.0f;
+
+    // Invalidate the cached layout when it was measured with a different font or wrap width
+    if (index->LayoutFont != font || index->LayoutFontSize != g.FontSize || index->LayoutWrapWidth != wrap_width || index->LayoutBuildGeneration != font->ContainerAtlas->BuildGeneration)
+    {
+        index->ClearLayout();
+        index->LayoutFont = font;
+        index->LayoutFontSize = g.FontSize;
+        index->LayoutWrapWidth = wrap_width;
+        index->LayoutBuildGeneration = font->ContainerAtlas->BuildGeneration;
+    }
+
+    // Measure new lines. The last line is only cached once terminated, as more text may still be appended to it.
+    const int lines_count = index->size();
+    const bool last_line_open = (lines_count > 0 && text[index->EndOffset - 1] != '\n');
+    const int lines_closed = last_line_open ? lines_count - 1 : lines_count;
+    if (index->LayoutLinesCount < lines_closed)
+    {
+        const int measure_offset_end = index->LineOffsets[index->LayoutLinesCount] + IMGUI_TEXT_INDEX_LAYOUT_BYTES_PER_FRAME;
+        int rows_count = TextIndexGetLineRow(index, index->LayoutLinesCount);
+        while (index->LayoutLinesCount < lines_closed && index->LineOffsets[index->LayoutLinesCount] < measure_offset_end)
+        {
+            const int line_no = index->LayoutLinesCount++;
+            const ImVec2 line_size = font->CalcTextSizeA(g.FontSize, FLT_MAX, wrap_width, index->get_line_begin(text, line_no), index->get_line_end(text, line_no));
+            index->LayoutMaxWidth = ImMax(index->LayoutMaxWidth, line_size.x);
+            if (wrap_enabled)
+            {
+                rows_count += ImMax((int)(line_size.y / line_height + 0.5f), 1);
+                index->LayoutRowsEnd.push_back(rows_count);
+            }
+        }
+    }
+
+    // Measure the open last line every frame, unless it is too large to do so
+    ImVec2 text_size(index->LayoutMaxWidth, 0.0f);
+    int last_line_extra_rows = 0;
+    if (last_line_open && index->LayoutLinesCount == lines_closed && index->EndOffset - index->LineOffsets[lines_closed] <= IMGUI_TEXT_INDEX_LAYOUT_BYTES_PER_FRAME)
+    {
+        const ImVec2 line_size = font->CalcTextSizeA(g.FontSize, FLT_MAX, wrap_width, index->get_line_begin(text, lines_closed), index->get_line_end(text, lines_closed));
+        text_size.x = ImMax(text_size.x, line_size.x);
+        if (wrap_enabled)
+            last_line_extra_rows = ImMax((int)(line_size.y / line_height + 0.5f), 1) - 1;
+    }
+    text_size.x = (float)(int)(text_size.x + 0.99999f);
+    const int rows_count = TextIndexGetLineRow(index, lines_count) + last_line_extra_rows;
+    text_size.y = rows_count * line_height;
+
+    // Visible rows (can't skip when logging text)
+    int row_min = 0;
+    int row_max = rows_count;
+    if (!g.LogEnabled)
+    {
+        row_min = ImClamp((int)((window->ClipRect.Min.y - text_pos.y) / line_height), 0, rows_count);
+        row_max = ImClamp((int)ImCeil((window->ClipRect.Max.y - text_pos.y) / line_height), row_min, rows_count);
+    }
+
+    // Render visible lines
+    const float scale = g.FontSize / font->FontSize;
+    const float clip_min_x = window->ClipRect.Min.x - line_height; // Extra margin for glyphs extending past their advance
+    const float clip_max_x = window->ClipRect.Max.x + line_height;
+    for (int line_no = (row_min < row_max) ? TextIndexFindLineAtRow(index, row_min) : lines_count; line_no < lines_count; line_no++)
+    {
+        const int row = TextIndexGetLineRow(index, line_no);
+        if (row >= row_max)
+            break;
+        ImVec2 pos(text_pos.x, text_pos.y + row * line_height);
+        const char* line_begin = index->get_line_begin(text, line_no);
+        const char* line_end = index->get_line_end(text, line_no);
+        if (wrap_enabled)
+        {
+            RenderTextWrapped(pos, line_begin, line_end, wrap_width);
+            continue;
+        }
+
+        // Horizontal clipping: skip characters left of the clipping rectangle and stop past its right edge
+        if (!g.LogEnabled)
+        {
+            const char* s = line_begin;
+            float x = pos.x;
+            while (s < line_end && x <= clip_max_x)
+            {
+                unsigned int c = (unsigned int)*s;
+                int c_len = 1;
+                if (c >= 0x80)
+                    c_len = ImTextCharFromUtf8(&c, s, line_end);
+                if (c_len == 0)
+                    break;
+                const float advance = (c == '\r') ? 0.0f : font->GetCharAdvance((ImWchar)c) * scale;
+                if (x + advance < clip_min_x)
+                {
+                    line_begin = s + c_len;
+                    pos.x = x + advance;
+                }
+                x += advance;
+                s += c_len;
+            }
+            line_end = s;
+        }
+        if (line_begin < line_end)
+            RenderText(pos, line_begin, line_end, false);
+    }
+
+    ImRect bb(text_pos, text_pos + text_size);
+    ItemSize(text_size, 0.0f);
+    ItemAdd(bb, 0);
+}
+
 void ImGui::Text(const char* fmt, ...)
 {
     va_list args;
@@ -3593,15 +3755,11 @@ bool ImGui::InputTextWithHint(const char* label, const char* hint, char* buf, si
 static int InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end)
 {
     int line_count = 0;
-    const char* s = text_begin;
-    while (char c = *s++) // We are only matching for \n so we can ignore UTF-8 decoding
-        if (c == '\n')
-            line_count++;
-    s--;
-    if (s[0] != '\n' && s[0] != '\r')
+    const char* text_end = text_begin + strlen(text_begin);
+    for (const char* s = text_begin; (s = (const char*)memchr(s, '\n', text_end - s)) != NULL; s++) // We are only matching for \n so we can ignore UTF-8 decoding
         line_count++;
-    *out_text_end = s;
-    return line_count;
+    *out_text_end = text_end;
+    return line_count + 1;
 }
 
 static ImVec2 InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining, ImVec2* out_offset, bool stop_on_new_line)
@@ -3684,20 +3842,58 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(ImGuiInputTextState* obj, int idx)
 #define STB_TEXTEDIT_MOVEWORDLEFT   STB_TEXTEDIT_MOVEWORDLEFT_IMPL    // They need to be #define for stb_textedit.h
 #define STB_TEXTEDIT_MOVEWORDRIGHT  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL
 
+// Rows are lines (we don't wrap), so both lookups are a binary search in LineStartsW instead of laying out every row from the start of the text.
+static void STB_TEXTEDIT_FINDROWBYINDEX_IMPL(ImGuiInputTextState* obj, int idx, int* out_first_char, int* out_prev_first_char, float* out_y)
+{
+    const int line_no = obj->GetLineFromPos(idx);
+    *out_first_char = obj->LineStartsW[line_no];
+    *out_prev_first_char = obj->LineStartsW[ImMax(line_no - 1, 0)];
+    *out_y = line_no * GImGui->FontSize;
+}
+static int STB_TEXTEDIT_FINDROWBYY_IMPL(ImGuiInputTextState* obj, float y)
+{
+    const float line_height = GImGui->FontSize;
+    int line_no = (y > 0.0f) ? (int)(y / line_height) : 0;
+    if (line_no > 0 && y < line_no * line_height)
+        line_no--;
+    else if (y >= (line_no + 1) * line_height)
+        line_no++;
+    return (line_no < obj->LineStartsW.Size) ? ImMin(obj->LineStartsW[line_no], obj->CurLenW) : obj->CurLenW;
+}
+#define STB_TEXTEDIT_FINDROWBYINDEX STB_TEXTEDIT_FINDROWBYINDEX_IMPL
+#define STB_TEXTEDIT_FINDROWBYY     STB_TEXTEDIT_FINDROWBYY_IMPL
+
 static void STB_TEXTEDIT_DELETECHARS(ImGuiInputTextState* obj, int pos, int n)
 {
     ImWchar* dst = obj->TextW.Data + pos;
+    const int line_first = obj->GetLineFromPos(pos);
+    const int line_last = obj->GetLineFromPos(pos + n);
+    const int pos_a = obj->LineStartsA[line_first] + ImTextCountUtf8BytesFromStr(obj->TextW.Data + obj->LineStartsW[line_first], dst);
+    const int n_a = ImTextCountUtf8BytesFromStr(dst, dst + n);
+
+    // Keep the UTF-8 copy in sync so we don't need to convert the whole text again after every edit
+    if (obj->TextAIsValid)
+        memmove(obj->TextA.Data + pos_a, obj->TextA.Data + pos_a + n_a, (size_t)(obj->CurLenA - pos_a - n_a + 1));
+
+    // Remove the lines started by the deleted new-lines and offset the following ones
+    if (line_last > line_first)
+    {
+        obj->LineStartsW.erase(obj->LineStartsW.Data + line_first + 1, obj->LineStartsW.Data + line_last + 1);
+        obj->LineStartsA.erase(obj->LineStartsA.Data + line_first + 1, obj->LineStartsA.Data + line_last + 1);
+    }
+    for (int line_no = line_first + 1; line_no < obj->LineStartsW.Size; line_no++)
+    {
+        obj->LineStartsW[line_no] -= n;
+        obj->LineStartsA[line_no] -= n_a;
+    }
 
     // We maintain our buffer length in both UTF-8 and wchar formats
     obj->Edited = true;
-    obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
+    obj->CurLenA -= n_a;
     obj->CurLenW -= n;
 
-    // Offset remaining text (FIXME-OPT: Use memmove)
-    const ImWchar* src = obj->TextW.Data + pos + n;
-    while (ImWchar c = *src++)
-        *dst++ = c;
-    *dst = '\0';
+    // Offset remaining text
+    memmove(dst, dst + n, (size_t)(obj->CurLenW - pos + 1) * sizeof(ImWchar));
 }
 
 static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const ImWchar* new_text, int new_text_len)
@@ -3720,6 +3916,46 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const Im
     }
 
     ImWchar* text = obj->TextW.Data;
+    const int line_first = obj->GetLineFromPos(pos);
+    const int pos_a = obj->LineStartsA[line_first] + ImTextCountUtf8BytesFromStr(text + obj->LineStartsW[line_first], text + pos);
+
+    // Keep the UTF-8 copy in sync so we don't need to convert the whole text again after every edit
+    if (obj->TextAIsValid)
+    {
+        if (obj->TextA.Size < obj->CurLenA + new_text_len_utf8 + 1)
+            obj->TextA.resize(obj->CurLenA + new_text_len_utf8 + 1);
+        char* text_a = obj->TextA.Data + pos_a;
+        memmove(text_a + new_text_len_utf8, text_a, (size_t)(obj->CurLenA - pos_a + 1));
+        const char backup_c = text_a[new_text_len_utf8];
+        ImTextStrToUtf8(text_a, new_text_len_utf8 + 1, new_text, new_text + new_text_len);
+        text_a[new_text_len_utf8] = backup_c;
+    }
+
+    // Offset the following lines and insert the lines started by new-lines in the new text
+    int new_lines_count = 0;
+    for (int n = 0; n < new_text_len; n++)
+        if (new_text[n] == '\n')
+            new_lines_count++;
+    const int line_next = line_first + 1;
+    const int lines_count = obj->LineStartsW.Size;
+    obj->LineStartsW.resize(lines_count + new_lines_count);
+    obj->LineStartsA.resize(lines_count + new_lines_count);
+    for (int line_no = lines_count - 1; line_no >= line_next; line_no--)
+    {
+        obj->LineStartsW[line_no + new_lines_count] = obj->LineStartsW[line_no] + new_text_len;
+        obj->LineStartsA[line_no + new_lines_count] = obj->LineStartsA[line_no] + new_text_len_utf8;
+    }
+    for (int n = 0, n_a = 0, line_no = line_next; n < new_text_len; n++)
+    {
+        n_a += ImTextCountUtf8BytesFromStr(new_text + n, new_text + n + 1);
+        if (new_text[n] == '\n')
+        {
+            obj->LineStartsW[line_no] = pos + n + 1;
+            obj->LineStartsA[line_no] = pos_a + n_a;
+            line_no++;
+        }
+    }
+
     if (pos != text_len)
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
     memcpy(text + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
@@ -3780,6 +4016,39 @@ void ImGuiInputTextState::OnKeyPressed(int key)
     CursorAnimReset();
 }
 
+void ImGuiInputTextState::RebuildLineIndex()
+{
+    LineStartsW.resize(0);
+    LineStartsA.resize(0);
+    LineStartsW.push_back(0);
+    LineStartsA.push_back(0);
+    const ImWchar* text = TextW.Data;
+    int line_start_a = 0;
+    for (const ImWchar* line_start = text, *text_end = text + CurLenW, *s = line_start; s < text_end; s++)
+        if (*s == '\n')
+        {
+            line_start_a += ImTextCountUtf8BytesFromStr(line_start, s + 1);
+            line_start = s + 1;
+            LineStartsW.push_back((int)(line_start - text));
+            LineStartsA.push_back(line_start_a);
+        }
+}
+
+int ImGuiInputTextState::GetLineFromPos(int pos) const
+{
+    // Last line starting at or before 'pos'
+    int line_min = 0, line_max = LineStartsW.Size - 1;
+    while (line_min < line_max)
+    {
+        const int line_mid = (line_min + line_max + 1) >> 1;
+        if (LineStartsW[line_mid] <= pos)
+            line_min = line_mid;
+        else
+            line_max = line_mid - 1;
+    }
+    return line_min;
+}
+
 ImGuiInputTextCallbackData::ImGuiInputTextCallbackData()
 {
     memset(this, 0, sizeof(*this));
@@ -4044,6 +4313,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextAIsValid = false;                // TextA is not valid yet (we will display buf until then)
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+        state->RebuildLineIndex();
 
         // Preserve cursor position and undo/redo stack if we come back to same widget
         // FIXME: For non-readonly widgets we might be able to require that TextAIsValid && TextA == buf ? (untested) and discard undo stack if user buffer has changed.
@@ -4110,6 +4380,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextW.resize(buf_size + 1);
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);
+        state->RebuildLineIndex();
         state->CursorClamp();
         render_selection &= state->HasSelection();
     }
@@ -4374,12 +4645,13 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             // Apply new value immediately - copy modified buffer back
             // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
             // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
-            // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
+            // Once valid, TextA is kept in sync by STB_TEXTEDIT_INSERTCHARS/STB_TEXTEDIT_DELETECHARS so we only convert the whole text once after activation.
             if (!is_readonly)
             {
-                state->TextAIsValid = true;
                 state->TextA.resize(state->TextW.Size * 4 + 1);
-                ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
+                if (!state->TextAIsValid)
+                    state->CurLenA = ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
+                state->TextAIsValid = true;
             }
 
             // User callback
@@ -4452,6 +4724,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                             state->TextW.resize(state->TextW.Size + (callback_data.BufTextLen - backup_current_text_length));
                         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, NULL);
                         state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        state->RebuildLineIndex();
                         state->CursorAnimReset();
                     }
                 }
@@ -4544,55 +4817,27 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // FIXME: This should occur on buf_display but we'd need to maintain cursor/select_start/select_end for UTF-8.
         const ImWchar* text_begin = state->TextW.Data;
         ImVec2 cursor_offset, select_start_offset;
+        int select_start_line_no = 0;
 
         {
-            // Find lines numbers straddling 'cursor' (slot 0) and 'select_start' (slot 1) positions.
-            const ImWchar* searches_input_ptr[2] = { NULL, NULL };
-            int searches_result_line_no[2] = { -1000, -1000 };
-            int searches_remaining = 0;
+            // Find lines straddling 'cursor' and 'select_start' positions with the line index, then calculate 2d position by measuring distance from the beginning of the line.
             if (render_cursor)
             {
-                searches_input_ptr[0] = text_begin + state->Stb.cursor;
-                searches_result_line_no[0] = -1;
-                searches_remaining++;
+                const int cursor_line_no = state->GetLineFromPos(state->Stb.cursor);
+                cursor_offset.x = InputTextCalcTextSizeW(text_begin + state->LineStartsW[cursor_line_no], text_begin + state->Stb.cursor).x;
+                cursor_offset.y = (cursor_line_no + 1) * g.FontSize;
             }
             if (render_selection)
             {
-                searches_input_ptr[1] = text_begin + ImMin(state->Stb.select_start, state->Stb.select_end);
-                searches_result_line_no[1] = -1;
-                searches_remaining++;
-            }
-
-            // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
-            int line_count = 0;
-            //for (const ImWchar* s = text_begin; (s = (const ImWchar*)wcschr((const wchar_t*)s, (wchar_t)'\n')) != NULL; s++)  // FIXME-OPT: Could use this when wchar_t are 16-bit
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
-                {
-                    line_count++;
-                    if (searches_result_line_no[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_no[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_no[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_no[1] = line_count; if (--searches_remaining <= 0) break; }
-                }
-            line_count++;
-            if (searches_result_line_no[0] == -1)
-                searches_result_line_no[0] = line_count;
-            if (searches_result_line_no[1] == -1)
-                searches_result_line_no[1] = line_count;
-
-            // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
-            cursor_offset.y = searches_result_line_no[0] * g.FontSize;
-            if (searches_result_line_no[1] >= 0)
-            {
-                select_start_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
-                select_start_offset.y = searches_result_line_no[1] * g.FontSize;
+                const int select_start = ImMin(state->Stb.select_start, state->Stb.select_end);
+                select_start_line_no = state->GetLineFromPos(select_start);
+                select_start_offset.x = InputTextCalcTextSizeW(text_begin + state->LineStartsW[select_start_line_no], text_begin + select_start).x;
+                select_start_offset.y = (select_start_line_no + 1) * g.FontSize;
             }
 
             // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
             if (is_multiline)
-                text_size = ImVec2(inner_size.x, line_count * g.FontSize);
+                text_size = ImVec2(inner_size.x, state->LineStartsW.Size * g.FontSize);
         }
 
         // Scroll
@@ -4641,17 +4886,18 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImVec2 rect_pos = draw_pos + select_start_offset - draw_scroll;
-            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            int line_no = select_start_line_no;
+            for (const ImWchar* p = text_selected_begin; p < text_selected_end; line_no++)
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
                 if (rect_pos.y < clip_rect.y)
                 {
-                    //p = (const ImWchar*)wmemchr((const wchar_t*)p, '\n', text_selected_end - p);  // FIXME-OPT: Could use this when wchar_t are 16-bit
-                    //p = p ? p + 1 : text_selected_end;
-                    while (p < text_selected_end)
-                        if (*p++ == '\n')
-                            break;
+                    // Skip all lines above the clipping rectangle at once using the line index
+                    const int skip_count = (int)((clip_rect.y - rect_pos.y) / g.FontSize) + 1;
+                    p = (line_no + skip_count < state->LineStartsW.Size) ? ImMin(text_begin + state->LineStartsW[line_no + skip_count], text_selected_end) : text_selected_end;
+                    rect_pos.y += (skip_count - 1) * g.FontSize;
+                    line_no += skip_count - 1;
                 }
                 else
                 {
@@ -4670,8 +4916,17 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // We test for 'buf_display_max_length' as a way to avoid some pathological cases (e.g. single-line 1 MB string) which would make ImDrawList crash.
         if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
+            // Start from the first visible line using the line index (TextA offsets are only valid when we display it)
+            ImVec2 text_pos = draw_pos - draw_scroll;
+            const char* text_display = buf_display;
+            if (is_multiline && buf_display_from_state && !is_displaying_hint && text_pos.y < clip_rect.y)
+            {
+                const int line_no = ImMin((int)((clip_rect.y - text_pos.y) / g.FontSize), state->LineStartsA.Size - 1);
+                text_display += state->LineStartsA[line_no];
+                text_pos.y += line_no * g.FontSize;
+            }
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
-            draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
+            draw_window->DrawList->AddText(g.Font, g.FontSize, text_pos, col, text_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
         }
 
         // Draw blinking cursor
@@ -5639,6 +5894,8 @@ void ImGui::ColorPickerOptionsPopup(const float* ref_col, ImGuiColorEditFlags fl
 // - TreePop()
 // - GetTreeNodeToLabelSpacing()
 // - SetNextItemOpen()
+// - ImGuiTreeView
+// - TreeViewNode()
 // - CollapsingHeader()
 //-------------------------------------------------------------------------
 
@@ -6025,6 +6282,214 @@ void ImGui::SetNextItemOpen(bool is_open, ImGuiCond cond)
     g.NextItemData.OpenCond = cond ? cond : ImGuiCond_Always;
 }
 
+ImGuiTreeView::ImGuiTreeView()
+{
+    DisplayStart = DisplayEnd = 0;
+    Storage = NULL;
+    IdSeed = 0;
+    StartPosX = 0.0f;
+    VisibleNodesDirty = false;
+}
+
+void ImGuiTreeView::Clear()
+{
+    Nodes.resize(0);
+    VisibleNodes.resize(0);
+    PendingToggles.resize(0);
+    AddNodeStack.resize(0);
+    VisibleNodesDirty = true;
+}
+
+int ImGuiTreeView::AddNode(int parent_idx, ImGuiID id)
+{
+    // Depth-first order: the parent must be on the path to the last added node. Nodes popped from that path are complete,
+    // so subtree sizes are written once per node instead of incrementing every ancestor, which would be O(N * depth).
+    IM_ASSERT(parent_idx >= -1 && parent_idx < Nodes.Size);
+    while (AddNodeStack.Size > 0 && AddNodeStack.back() != parent_idx)
+    {
+        Nodes[AddNodeStack.back()].SubtreeSize = Nodes.Size - AddNodeStack.back();
+        AddNodeStack.pop_back();
+    }
+    IM_ASSERT((parent_idx == -1 || AddNodeStack.Size > 0) && "Nodes must be added in depth-first order!");
+    ImGuiTreeViewNode node;
+    node.Id = id;
+    node.Parent = parent_idx;
+    node.Depth = (parent_idx >= 0) ? Nodes[parent_idx].Depth + 1 : 0;
+    node.SubtreeSize = 1;
+    node.IsOpen = false;
+    Nodes.push_back(node);
+    AddNodeStack.push_back(Nodes.Size - 1);
+    VisibleNodesDirty = true;
+    return Nodes.Size - 1;
+}
+
+ImGuiID ImGuiTreeView::GetNodeID(int node_idx) const
+{
+    return ImHashData(&Nodes[node_idx].Id, sizeof(ImGuiID), IdSeed);
+}
+
+int ImGuiTreeView::GetRowOfNode(int node_idx) const
+{
+    // Rows are sorted by node index
+    int lo = 0, hi = VisibleNodes.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (VisibleNodes[mid] < node_idx)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return (lo < VisibleNodes.Size && VisibleNodes[lo] == node_idx) ? lo : -1;
+}
+
+// Append the visible descendants of 'node_idx' to 'out_nodes', skipping the subtrees of closed nodes
+static void TreeViewAddVisibleDescendants(const ImGuiTreeView* tree, int node_idx, ImVector<int>* out_nodes)
+{
+    const int subtree_end = node_idx + tree->Nodes[node_idx].SubtreeSize;
+    for (int n = node_idx + 1; n < subtree_end; )
+    {
+        out_nodes->push_back(n);
+        n += tree->Nodes[n].IsOpen ? 1 : tree->Nodes[n].SubtreeSize;
+    }
+}
+
+void ImGuiTreeView::SetNodeOpen(int node_idx, bool open)
+{
+    IM_ASSERT(Storage != NULL && "Call Begin() first!");
+    ImGuiTreeViewNode& node = Nodes[node_idx];
+    Storage->SetInt(GetNodeID(node_idx), open ? 1 : 0);
+    if (node.IsOpen == open || node.SubtreeSize == 1)
+    {
+        node.IsOpen = open;
+        return;
+    }
+    node.IsOpen = open;
+
+    // Hidden by a closed ancestor: no visible rows to update
+    const int row = GetRowOfNode(node_idx);
+    if (row < 0)
+        return;
+
+    if (open)
+    {
+        // Insert rows of the visible descendants after the node
+        const int old_size = VisibleNodes.Size;
+        TreeViewAddVisibleDescendants(this, node_idx, &VisibleNodes);
+        const int count = VisibleNodes.Size - old_size;
+        ImVector<int> inserted_nodes;
+        inserted_nodes.resize(count);
+        memcpy(inserted_nodes.Data, VisibleNodes.Data + old_size, (size_t)count * sizeof(int));
+        memmove(VisibleNodes.Data + row + 1 + count, VisibleNodes.Data + row + 1, (size_t)(old_size - row - 1) * sizeof(int));
+        memcpy(VisibleNodes.Data + row + 1, inserted_nodes.Data, (size_t)count * sizeof(int));
+    }
+    else
+    {
+        // Remove rows of the descendants: they are the rows up to the first node after the subtree
+        const int subtree_end = node_idx + node.SubtreeSize;
+        int row_end = row + 1;
+        for (int hi = VisibleNodes.Size; row_end < hi; )
+        {
+            const int mid = (row_end + hi) >> 1;
+            if (VisibleNodes[mid] < subtree_end)
+                row_end = mid + 1;
+            else
+                hi = mid;
+        }
+        VisibleNodes.erase(VisibleNodes.Data + row + 1, VisibleNodes.Data + row_end);
+    }
+}
+
+void ImGuiTreeView::Begin()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+
+    // Open states are read from the window storage, with IDs depending on the ID stack
+    const ImGuiID id_seed = window->IDStack.back();
+    if (id_seed != IdSeed || window->DC.StateStorage != Storage)
+    {
+        IdSeed = id_seed;
+        Storage = window->DC.StateStorage;
+        VisibleNodesDirty = true;
+    }
+    if (VisibleNodesDirty)
+    {
+        // Subtrees on the path to the last added node may still grow: update their size without popping them
+        for (int i = 0; i < AddNodeStack.Size; i++)
+            Nodes[AddNodeStack[i]].SubtreeSize = Nodes.Size - AddNodeStack[i];
+        for (int n = 0; n < Nodes.Size; n++)
+            Nodes[n].IsOpen = (Nodes[n].SubtreeSize > 1) && Storage->GetInt(GetNodeID(n), 0) != 0;
+        VisibleNodes.resize(0);
+        for (int n = 0; n < Nodes.Size; n += Nodes[n].IsOpen ? 1 : Nodes[n].SubtreeSize)
+            VisibleNodes.push_back(n);
+        PendingToggles.resize(0);
+        VisibleNodesDirty = false;
+    }
+    for (int i = 0; i < PendingToggles.Size; i++)
+        SetNodeOpen(PendingToggles[i], !Nodes[PendingToggles[i]].IsOpen);
+    PendingToggles.resize(0);
+
+    StartPosX = window->DC.CursorPos.x;
+    DisplayStart = DisplayEnd = 0;
+    Clipper.Begin(VisibleNodes.Size);
+}
+
+bool ImGuiTreeView::Step()
+{
+    if (Clipper.Step())
+    {
+        DisplayStart = Clipper.DisplayStart;
+        DisplayEnd = Clipper.DisplayEnd;
+        return true;
+    }
+
+    // Apply open state changes now that rows are not being iterated anymore
+    for (int i = 0; i < PendingToggles.Size; i++)
+        SetNodeOpen(PendingToggles[i], !Nodes[PendingToggles[i]].IsOpen);
+    PendingToggles.resize(0);
+    DisplayStart = DisplayEnd = 0;
+    return false;
+}
+
+bool ImGui::TreeViewNode(ImGuiTreeView* tree, int row, const char* label, ImGuiTreeNodeFlags flags)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(row >= 0 && row < tree->VisibleNodes.Size);
+    const int node_idx = tree->VisibleNodes[row];
+    const ImGuiTreeViewNode& node = tree->Nodes[node_idx];
+    const ImGuiID id = tree->GetNodeID(node_idx);
+    const bool is_leaf = (node.SubtreeSize == 1);
+    flags |= ImGuiTreeNodeFlags_NoTreePushOnOpen | (is_leaf ? ImGuiTreeNodeFlags_Leaf : 0);
+    window->DC.CursorPos.x = tree->StartPosX + node.Depth * g.Style.IndentSpacing;
+
+    // Left arrow on a closed node moves to its parent, which may not be submitted this frame (rows have the same height, so we know where it is).
+    // The clipper doesn't measure the row height before it submits the first row, which is always a root node.
+    const ImGuiListClipper& clipper = tree->Clipper;
+    if (g.NavId == id && g.NavWindow == window && g.NavMoveRequest && g.NavMoveDir == ImGuiDir_Left && (is_leaf || !node.IsOpen) && node.Parent >= 0 && clipper.ItemsHeight > 0.0f)
+    {
+        const int parent_row = tree->GetRowOfNode(node.Parent);
+        const float parent_y = clipper.StartPosY + (parent_row - clipper.ItemsFrozen) * clipper.ItemsHeight;
+        const ImRect parent_rect(tree->StartPosX + tree->Nodes[node.Parent].Depth * g.Style.IndentSpacing, parent_y, window->WorkRect.Max.x, parent_y + clipper.ItemsHeight - g.Style.ItemSpacing.y);
+        SetNavID(tree->GetNodeID(node.Parent), g.NavLayer, window->DC.NavFocusScopeIdCurrent, ImRect(parent_rect.Min - window->Pos, parent_rect.Max - window->Pos));
+        NavMoveRequestCancel();
+        g.NavDisableHighlight = false;
+        ScrollToBringRectIntoView(window, parent_rect);
+    }
+
+    const bool is_open = TreeNodeBehavior(id, flags, label, NULL);
+
+    // Open state changed by TreeNodeBehavior() (or SetNextItemOpen()): update rows once we are done iterating them.
+    // When logging is enabled TreeNodeBehavior() reports nodes as open without changing their state.
+    if (!is_leaf && is_open != node.IsOpen && !g.LogEnabled)
+        tree->PendingToggles.push_back(node_idx);
+    return is_open;
+}
+
 // CollapsingHeader returns true when opened but do not indent nor push into the ID stack (because of the ImGuiTreeNodeFlags_NoTreePushOnOpen flag).
 // This is basically the same as calling TreeNodeEx(label, ImGuiTreeNodeFlags_CollapsingHeader). You can remove the _NoTreePushOnOpen flag if you want behavior closer to normal TreeNode().
 bool ImGui::CollapsingHeader(const char* label, ImGuiTreeNodeFlags flags)
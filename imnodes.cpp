@@ -2,6 +2,7 @@
 //
 // [SECTION] bezier curve helpers
 // [SECTION] draw list helper
+// [SECTION] spatial grid
 // [SECTION] ui state logic
 // [SECTION] render helpers
 // [SECTION] API implementation
@@ -306,36 +307,6 @@ void ImDrawListGrowChannels(ImDrawList* draw_list, const int num_channels)
     }
 }
 
-void ImDrawListSplitterSwapChannels(
-    ImDrawListSplitter& splitter,
-    const int           lhs_idx,
-    const int           rhs_idx)
-{
-    if (lhs_idx == rhs_idx)
-    {
-        return;
-    }
-
-    assert(lhs_idx >= 0 && lhs_idx < splitter._Count);
-    assert(rhs_idx >= 0 && rhs_idx < splitter._Count);
-
-    ImDrawChannel& lhs_channel = splitter._Channels[lhs_idx];
-    ImDrawChannel& rhs_channel = splitter._Channels[rhs_idx];
-    lhs_channel._CmdBuffer.swap(rhs_channel._CmdBuffer);
-    lhs_channel._IdxBuffer.swap(rhs_channel._IdxBuffer);
-
-    const int current_channel = splitter._Current;
-
-    if (current_channel == lhs_idx)
-    {
-        splitter._Current = rhs_idx;
-    }
-    else if (current_channel == rhs_idx)
-    {
-        splitter._Current = lhs_idx;
-    }
-}
-
 void DrawListSet(ImDrawList* window_draw_list)
 {
     GImNodes->CanvasDrawList = window_draw_list;
@@ -419,73 +390,400 @@ void DrawListActivateNodeBackground(const int node_idx)
         GImNodes->CanvasDrawList, background_channel_idx);
 }
 
-void DrawListSwapSubmissionIndices(const int lhs_idx, const int rhs_idx)
+void DrawListSortChannelsByDepth(const ImNodesEditorContext& editor)
 {
-    assert(lhs_idx != rhs_idx);
+    ImVector<int>& submission_order = GImNodes->NodeIdxSubmissionOrder;
+
+    // Culled nodes don't have draw channels, leave them out of the depth order
+    const ImVector<int>* depth_order = &editor.NodeDepthOrder;
+    if (GImNodes->CulledNodeCount > 0)
+    {
+        ImVector<int>& visible_depth_order = GImNodes->VisibleNodeDepthOrder;
+        visible_depth_order.resize(0);
+        for (int depth_idx = 0; depth_idx < editor.NodeDepthOrder.size(); ++depth_idx)
+        {
+            const int node_idx = editor.NodeDepthOrder[depth_idx];
+            if (!editor.Nodes.Pool[node_idx].Culled)
+            {
+                visible_depth_order.push_back(node_idx);
+            }
+        }
+        depth_order = &visible_depth_order;
+    }
+    const ImVector<int>& node_idx_depth_order = *depth_order;
+
+    if (submission_order.Size < 2)
+    {
+        return;
+    }
+
+    assert(node_idx_depth_order.Size == submission_order.Size);
+
+    // early out if submission order and depth order are the same
+    if (memcmp(
+            node_idx_depth_order.Data,
+            submission_order.Data,
+            static_cast<size_t>(submission_order.size_in_bytes())) == 0)
+    {
+        return;
+    }
 
-    const int lhs_foreground_channel_idx = DrawListSubmissionIdxToForegroundChannelIdx(lhs_idx);
-    const int lhs_background_channel_idx = DrawListSubmissionIdxToBackgroundChannelIdx(lhs_idx);
-    const int rhs_foreground_channel_idx = DrawListSubmissionIdxToForegroundChannelIdx(rhs_idx);
-    const int rhs_background_channel_idx = DrawListSubmissionIdxToBackgroundChannelIdx(rhs_idx);
+    // Each node owns a background and a foreground channel. Rather than moving nodes up one
+    // position at a time, every channel pair is moved directly to the slot of its node in the
+    // depth order. ImDrawChannel only holds two ImVectors, so the channels are relocated with
+    // memcpy through a scratch buffer which never owns their memory.
 
-    ImDrawListSplitterSwapChannels(
-        GImNodes->CanvasDrawList->_Splitter,
-        lhs_background_channel_idx,
-        rhs_background_channel_idx);
-    ImDrawListSplitterSwapChannels(
-        GImNodes->CanvasDrawList->_Splitter,
-        lhs_foreground_channel_idx,
-        rhs_foreground_channel_idx);
+    ImDrawListSplitter&      splitter = GImNodes->CanvasDrawList->_Splitter;
+    ImVector<ImDrawChannel>& scratch = GImNodes->NodeChannelsScratch;
+    const int                first_channel_idx = DrawListSubmissionIdxToBackgroundChannelIdx(0);
+    const int                num_node_channels = 2 * submission_order.Size;
+
+    assert(first_channel_idx + num_node_channels <= splitter._Count);
+
+    scratch.resize(num_node_channels);
+    memcpy(
+        static_cast<void*>(scratch.Data),
+        splitter._Channels.Data + first_channel_idx,
+        static_cast<size_t>(scratch.size_in_bytes()));
+
+    const int current_channel = splitter._Current;
+    const int current_submission_idx = (current_channel - first_channel_idx) >> 1;
+
+    for (int depth_idx = 0; depth_idx < node_idx_depth_order.Size; ++depth_idx)
+    {
+        const int node_idx = node_idx_depth_order[depth_idx];
+        const int submission_idx =
+            GImNodes->NodeIdxToSubmissionIdx.GetInt(static_cast<ImGuiID>(node_idx), -1);
+        assert(submission_idx >= 0);
+
+        const int channel_idx = DrawListSubmissionIdxToBackgroundChannelIdx(depth_idx);
+        memcpy(
+            static_cast<void*>(splitter._Channels.Data + channel_idx),
+            scratch.Data + 2 * submission_idx,
+            2 * sizeof(ImDrawChannel));
+
+        if (current_channel >= first_channel_idx && submission_idx == current_submission_idx)
+        {
+            splitter._Current = channel_idx + ((current_channel - first_channel_idx) & 1);
+        }
+    }
+
+    submission_order = node_idx_depth_order;
+}
+
+// [SECTION] spatial grid
+
+// Objects overlapping more cells than this are kept in ImSpatialGrid::LargeObjects instead of being
+// inserted into every cell, e.g. links spanning a large part of the graph.
+const int SPATIAL_GRID_MAX_CELLS_PER_OBJECT = 64;
+
+inline ImSpatialGrid::CellRange SpatialGridGetCellRange(
+    const ImSpatialGrid& grid,
+    const ImRect&        grid_space_rect)
+{
+    const float              inv_cell_size = 1.f / grid.CellSize;
+    ImSpatialGrid::CellRange range;
+    range.MinX = static_cast<int>(floorf(grid_space_rect.Min.x * inv_cell_size));
+    range.MinY = static_cast<int>(floorf(grid_space_rect.Min.y * inv_cell_size));
+    range.MaxX = static_cast<int>(floorf(grid_space_rect.Max.x * inv_cell_size));
+    range.MaxY = static_cast<int>(floorf(grid_space_rect.Max.y * inv_cell_size));
+    return range;
 }
 
-void DrawListSortChannelsByDepth(const ImVector<int>& node_idx_depth_order)
+inline bool SpatialGridIsLargeRange(const ImSpatialGrid::CellRange& range)
 {
-    if (GImNodes->NodeIdxToSubmissionIdx.Data.Size < 2)
+    const int width = range.MaxX - range.MinX + 1;
+    const int height = range.MaxY - range.MinY + 1;
+    return width > SPATIAL_GRID_MAX_CELLS_PER_OBJECT ||
+           height > SPATIAL_GRID_MAX_CELLS_PER_OBJECT ||
+           width * height > SPATIAL_GRID_MAX_CELLS_PER_OBJECT;
+}
+
+inline int SpatialGridHashCell(const int x, const int y)
+{
+    return static_cast<int>(
+        (static_cast<ImU32>(x) * 73856093u) ^ (static_cast<ImU32>(y) * 19349663u));
+}
+
+void SpatialGridRehash(ImSpatialGrid& grid)
+{
+    // Empty cells are dropped here, so the table doesn't keep growing as nodes are moved around.
+    int num_live_cells = 0;
+    for (int i = 0; i < grid.Cells.Size; ++i)
     {
-        return;
+        if (grid.Cells[i].FirstEntry >= 0)
+        {
+            ++num_live_cells;
+        }
     }
 
-    assert(node_idx_depth_order.Size == GImNodes->NodeIdxSubmissionOrder.Size);
+    int new_size = 64;
+    while (new_size < num_live_cells * 4)
+    {
+        new_size *= 2;
+    }
 
-    int start_idx = node_idx_depth_order.Size - 1;
+    ImVector<ImSpatialGrid::Cell> old_cells;
+    old_cells.swap(grid.Cells);
+    ImSpatialGrid::Cell unused_cell;
+    unused_cell.X = unused_cell.Y = 0;
+    unused_cell.FirstEntry = -2;
+    grid.Cells.resize(new_size, unused_cell);
+    grid.CellsUsed = num_live_cells;
 
-    while (node_idx_depth_order[start_idx] == GImNodes->NodeIdxSubmissionOrder[start_idx])
+    const int mask = new_size - 1;
+    for (int i = 0; i < old_cells.Size; ++i)
     {
-        if (--start_idx == 0)
+        const ImSpatialGrid::Cell& cell = old_cells[i];
+        if (cell.FirstEntry < 0)
         {
-            // early out if submission order and depth order are the same
-            return;
+            continue;
+        }
+
+        int slot = SpatialGridHashCell(cell.X, cell.Y) & mask;
+        while (grid.Cells[slot].FirstEntry != -2)
+        {
+            slot = (slot + 1) & mask;
         }
+        grid.Cells[slot] = cell;
     }
+}
 
-    // TODO: this is an O(N^2) algorithm. It might be worthwhile revisiting this to see if the time
-    // complexity can be reduced.
+ImSpatialGrid::Cell* SpatialGridFindCell(
+    ImSpatialGrid& grid,
+    const int      x,
+    const int      y,
+    const bool     create)
+{
+    if (create && (grid.CellsUsed + 1) * 2 > grid.Cells.Size)
+    {
+        SpatialGridRehash(grid);
+    }
 
-    for (int depth_idx = start_idx; depth_idx > 0; --depth_idx)
+    if (grid.Cells.empty())
     {
-        const int node_idx = node_idx_depth_order[depth_idx];
+        return NULL;
+    }
 
-        // Find the current index of the node_idx in the submission order array
-        int submission_idx = -1;
-        for (int i = 0; i < GImNodes->NodeIdxSubmissionOrder.Size; ++i)
+    const int mask = grid.Cells.Size - 1;
+    for (int slot = SpatialGridHashCell(x, y) & mask;; slot = (slot + 1) & mask)
+    {
+        ImSpatialGrid::Cell& cell = grid.Cells[slot];
+        if (cell.FirstEntry == -2)
         {
-            if (GImNodes->NodeIdxSubmissionOrder[i] == node_idx)
+            if (!create)
             {
-                submission_idx = i;
-                break;
+                return NULL;
             }
+            cell.X = x;
+            cell.Y = y;
+            cell.FirstEntry = -1;
+            ++grid.CellsUsed;
+            return &cell;
         }
-        assert(submission_idx >= 0);
 
-        if (submission_idx == depth_idx)
+        if (cell.X == x && cell.Y == y)
         {
-            continue;
+            return &cell;
         }
+    }
+}
+
+void SpatialGridInsert(
+    ImSpatialGrid&                  grid,
+    const int                       object_idx,
+    const ImSpatialGrid::CellRange& range)
+{
+    if (SpatialGridIsLargeRange(range))
+    {
+        grid.LargeObjects.push_back(object_idx);
+        return;
+    }
 
-        for (int j = submission_idx; j < depth_idx; ++j)
+    for (int y = range.MinY; y <= range.MaxY; ++y)
+    {
+        for (int x = range.MinX; x <= range.MaxX; ++x)
         {
-            DrawListSwapSubmissionIndices(j, j + 1);
-            ImSwap(GImNodes->NodeIdxSubmissionOrder[j], GImNodes->NodeIdxSubmissionOrder[j + 1]);
+            ImSpatialGrid::Cell* const cell = SpatialGridFindCell(grid, x, y, true);
+
+            int entry_idx = grid.FreeEntry;
+            if (entry_idx != -1)
+            {
+                grid.FreeEntry = grid.Entries[entry_idx].NextEntry;
+            }
+            else
+            {
+                entry_idx = grid.Entries.Size;
+                grid.Entries.push_back(ImSpatialGrid::Entry());
+            }
+
+            ImSpatialGrid::Entry& entry = grid.Entries[entry_idx];
+            entry.ObjectIdx = object_idx;
+            entry.NextEntry = cell->FirstEntry;
+            cell->FirstEntry = entry_idx;
+        }
+    }
+}
+
+void SpatialGridRemove(
+    ImSpatialGrid&                  grid,
+    const int                       object_idx,
+    const ImSpatialGrid::CellRange& range)
+{
+    if (SpatialGridIsLargeRange(range))
+    {
+        grid.LargeObjects.find_erase_unsorted(object_idx);
+        return;
+    }
+
+    for (int y = range.MinY; y <= range.MaxY; ++y)
+    {
+        for (int x = range.MinX; x <= range.MaxX; ++x)
+        {
+            ImSpatialGrid::Cell* const cell = SpatialGridFindCell(grid, x, y, false);
+            assert(cell != NULL);
+
+            for (int* entry_idx = &cell->FirstEntry; *entry_idx != -1;
+                 entry_idx = &grid.Entries[*entry_idx].NextEntry)
+            {
+                ImSpatialGrid::Entry& entry = grid.Entries[*entry_idx];
+                if (entry.ObjectIdx == object_idx)
+                {
+                    const int removed_entry_idx = *entry_idx;
+                    *entry_idx = entry.NextEntry;
+                    entry.NextEntry = grid.FreeEntry;
+                    grid.FreeEntry = removed_entry_idx;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void SpatialGridRemoveObject(ImSpatialGrid& grid, const int object_idx)
+{
+    if (object_idx >= grid.ObjectCells.Size)
+    {
+        return;
+    }
+
+    ImSpatialGrid::CellRange& range = grid.ObjectCells[object_idx];
+    if (range.MinX <= range.MaxX)
+    {
+        SpatialGridRemove(grid, object_idx, range);
+        range.MinX = 1;
+        range.MaxX = 0;
+    }
+}
+
+void SpatialGridUpdateObject(
+    ImSpatialGrid& grid,
+    const int      object_idx,
+    const ImRect&  grid_space_rect)
+{
+    if (object_idx >= grid.ObjectCells.Size)
+    {
+        ImSpatialGrid::CellRange empty_range;
+        empty_range.MinX = empty_range.MinY = 1;
+        empty_range.MaxX = empty_range.MaxY = 0;
+        grid.ObjectCells.resize(object_idx + 1, empty_range);
+    }
+
+    const ImSpatialGrid::CellRange new_range = SpatialGridGetCellRange(grid, grid_space_rect);
+    ImSpatialGrid::CellRange&      range = grid.ObjectCells[object_idx];
+
+    if (range.MinX == new_range.MinX && range.MinY == new_range.MinY &&
+        range.MaxX == new_range.MaxX && range.MaxY == new_range.MaxY)
+    {
+        return;
+    }
+
+    const bool in_grid = range.MinX <= range.MaxX;
+    if (!(in_grid && SpatialGridIsLargeRange(range) && SpatialGridIsLargeRange(new_range)))
+    {
+        if (in_grid)
+        {
+            SpatialGridRemove(grid, object_idx, range);
+        }
+        SpatialGridInsert(grid, object_idx, new_range);
+    }
+
+    range = new_range;
+}
+
+inline void SpatialGridQueryCell(
+    ImSpatialGrid&             grid,
+    const ImSpatialGrid::Cell& cell,
+    ImVector<int>&             object_indices)
+{
+    for (int entry_idx = cell.FirstEntry; entry_idx >= 0;
+         entry_idx = grid.Entries[entry_idx].NextEntry)
+    {
+        const int object_idx = grid.Entries[entry_idx].ObjectIdx;
+        if (grid.ObjectQueryMarks[object_idx] != grid.QueryMark)
+        {
+            grid.ObjectQueryMarks[object_idx] = grid.QueryMark;
+            object_indices.push_back(object_idx);
+        }
+    }
+}
+
+// Fills `object_indices` with the objects overlapping the cells covered by the grid-space
+// rectangle, each object once. The caller still needs to test the objects against the rectangle.
+void SpatialGridQuery(
+    ImSpatialGrid& grid,
+    const ImRect&  grid_space_rect,
+    ImVector<int>& object_indices)
+{
+    object_indices.resize(0);
+
+    if (grid.ObjectQueryMarks.Size < grid.ObjectCells.Size)
+    {
+        grid.ObjectQueryMarks.resize(grid.ObjectCells.Size, 0);
+    }
+
+    if (grid.QueryMark == INT_MAX)
+    {
+        memset(grid.ObjectQueryMarks.Data, 0, grid.ObjectQueryMarks.size_in_bytes());
+        grid.QueryMark = 0;
+    }
+    ++grid.QueryMark;
+
+    for (int i = 0; i < grid.LargeObjects.Size; ++i)
+    {
+        const int object_idx = grid.LargeObjects[i];
+        grid.ObjectQueryMarks[object_idx] = grid.QueryMark;
+        object_indices.push_back(object_idx);
+    }
+
+    const ImSpatialGrid::CellRange range = SpatialGridGetCellRange(grid, grid_space_rect);
+    const float                    num_cells_in_range =
+        float(range.MaxX - range.MinX + 1) * float(range.MaxY - range.MinY + 1);
+
+    if (num_cells_in_range > float(grid.CellsUsed))
+    {
+        // The range covers more cells than the grid contains, walk the hash table instead
+        for (int slot = 0; slot < grid.Cells.Size; ++slot)
+        {
+            const ImSpatialGrid::Cell& cell = grid.Cells[slot];
+            if (cell.FirstEntry >= 0 && cell.X >= range.MinX && cell.X <= range.MaxX &&
+                cell.Y >= range.MinY && cell.Y <= range.MaxY)
+            {
+                SpatialGridQueryCell(grid, cell, object_indices);
+            }
+        }
+        return;
+    }
+
+    for (int y = range.MinY; y <= range.MaxY; ++y)
+    {
+        for (int x = range.MinX; x <= range.MaxX; ++x)
+        {
+            const ImSpatialGrid::Cell* const cell = SpatialGridFindCell(grid, x, y, false);
+            if (cell != NULL)
+            {
+                SpatialGridQueryCell(grid, *cell, object_indices);
+            }
         }
     }
 }
@@ -519,6 +817,86 @@ bool MouseInCanvas()
            GImNodes->CanvasRectScreenSpace.Contains(ImGui::GetMousePos());
 }
 
+inline ImVec2 ScreenSpaceToGridSpace(const ImNodesEditorContext& editor, const ImVec2& v);
+
+inline ImRect ScreenSpaceToGridSpace(const ImNodesEditorContext& editor, const ImRect& r)
+{
+    return ImRect(ScreenSpaceToGridSpace(editor, r.Min), ScreenSpaceToGridSpace(editor, r.Max));
+}
+
+// Brings the node and link grids up to date with the node rectangles and pin positions submitted
+// this frame. This runs at most once per frame, and only when hit-testing is needed.
+void SpatialGridsUpdate(ImNodesEditorContext& editor)
+{
+    const int frame = ImGui::GetFrameCount();
+    if (editor.SpatialGridsFrame == frame)
+    {
+        return;
+    }
+    editor.SpatialGridsFrame = frame;
+
+    for (int node_idx = 0; node_idx < editor.Nodes.Pool.size(); ++node_idx)
+    {
+        if (editor.Nodes.InUse[node_idx])
+        {
+            const ImRect& node_rect = editor.Nodes.Pool[node_idx].Rect;
+            SpatialGridUpdateObject(
+                editor.NodeGrid, node_idx, ScreenSpaceToGridSpace(editor, node_rect));
+        }
+        else
+        {
+            SpatialGridRemoveObject(editor.NodeGrid, node_idx);
+        }
+    }
+
+    for (int link_idx = 0; link_idx < editor.Links.Pool.size(); ++link_idx)
+    {
+        if (editor.Links.InUse[link_idx])
+        {
+            const ImLinkData& link = editor.Links.Pool[link_idx];
+            const ImPinData&  start_pin = editor.Pins.Pool[link.StartPinIdx];
+            const ImPinData&  end_pin = editor.Pins.Pool[link.EndPinIdx];
+            const CubicBezier cubic_bezier = GetCubicBezier(
+                GetScreenSpacePinCoordinates(editor, start_pin),
+                GetScreenSpacePinCoordinates(editor, end_pin),
+                start_pin.Type,
+                GImNodes->Style.LinkLineSegmentsPerLength);
+            SpatialGridUpdateObject(
+                editor.LinkGrid,
+                link_idx,
+                ScreenSpaceToGridSpace(editor, GetContainingRectForCubicBezier(cubic_bezier)));
+        }
+        else
+        {
+            SpatialGridRemoveObject(editor.LinkGrid, link_idx);
+        }
+    }
+}
+
+// Maps node indices to their position in the depth stack, so that the relative depth of two nodes
+// can be compared without searching the depth stack.
+void UpdateNodeDepthIndices(const ImNodesEditorContext& editor)
+{
+    ImVector<int>&       node_idx_to_depth_idx = GImNodes->NodeIdxToDepthIdx;
+    const ImVector<int>& depth_stack = editor.NodeDepthOrder;
+
+    node_idx_to_depth_idx.resize(editor.Nodes.Pool.size());
+    if (!node_idx_to_depth_idx.empty())
+    {
+        memset(node_idx_to_depth_idx.Data, 0xff, node_idx_to_depth_idx.size_in_bytes());
+    }
+
+    for (int depth_idx = 0; depth_idx < depth_stack.size(); ++depth_idx)
+    {
+        node_idx_to_depth_idx[depth_stack[depth_idx]] = depth_idx;
+    }
+}
+
+int CompareIndices(const void* lhs, const void* rhs)
+{
+    return *static_cast<const int*>(lhs) - *static_cast<const int*>(rhs);
+}
+
 void BeginNodeSelection(ImNodesEditorContext& editor, const int node_idx)
 {
     // Don't start selecting a node if we are e.g. already creating and dragging
@@ -535,11 +913,11 @@ void BeginNodeSelection(ImNodesEditorContext& editor, const int node_idx)
     //
     // Otherwise, we want to allow for the possibility of multiple nodes to be
     // moved at once.
-    if (!editor.SelectedNodeIndices.contains(node_idx))
+    if (!SelectionContains(editor.SelectedNodes, node_idx))
     {
-        editor.SelectedNodeIndices.clear();
-        editor.SelectedLinkIndices.clear();
-        editor.SelectedNodeIndices.push_back(node_idx);
+        SelectionClear(editor.SelectedNodes);
+        SelectionClear(editor.SelectedLinks);
+        SelectionAdd(editor.SelectedNodes, node_idx);
 
         // Ensure that individually selected nodes get rendered on top
         ImVector<int>&   depth_stack = editor.NodeDepthOrder;
@@ -555,9 +933,9 @@ void BeginLinkSelection(ImNodesEditorContext& editor, const int link_idx)
     editor.ClickInteraction.Type = ImNodesClickInteractionType_Link;
     // When a link is selected, clear all other selections, and insert the link
     // as the sole selection.
-    editor.SelectedNodeIndices.clear();
-    editor.SelectedLinkIndices.clear();
-    editor.SelectedLinkIndices.push_back(link_idx);
+    SelectionClear(editor.SelectedNodes);
+    SelectionClear(editor.SelectedLinks);
+    SelectionAdd(editor.SelectedLinks, link_idx);
 }
 
 void BeginLinkDetach(ImNodesEditorContext& editor, const int link_idx, const int detach_pin_idx)
@@ -684,53 +1062,72 @@ void BoxSelectorUpdateSelection(ImNodesEditorContext& editor, ImRect box_rect)
         ImSwap(box_rect.Min.y, box_rect.Max.y);
     }
 
-    // Update node selection
+    SpatialGridsUpdate(editor);
 
-    editor.SelectedNodeIndices.clear();
+    const ImRect   grid_space_box_rect = ScreenSpaceToGridSpace(editor, box_rect);
+    ImVector<int>& candidate_indices = GImNodes->SpatialQueryResults;
 
-    // Test for overlap against node rectangles
+    // Update node selection. Only the previously selected and the candidate nodes are touched.
 
-    for (int node_idx = 0; node_idx < editor.Nodes.Pool.size(); ++node_idx)
+    SelectionClear(editor.SelectedNodes);
+
+    // Test for overlap against the rectangles of the nodes in the grid cells under the box
+
+    SpatialGridQuery(editor.NodeGrid, grid_space_box_rect, candidate_indices);
+    for (int i = 0; i < candidate_indices.size(); ++i)
     {
-        if (editor.Nodes.InUse[node_idx])
+        const int         node_idx = candidate_indices[i];
+        const ImNodeData& node = editor.Nodes.Pool[node_idx];
+        if (box_rect.Overlaps(node.Rect))
         {
-            ImNodeData& node = editor.Nodes.Pool[node_idx];
-            if (box_rect.Overlaps(node.Rect))
-            {
-                editor.SelectedNodeIndices.push_back(node_idx);
-            }
+            SelectionAdd(editor.SelectedNodes, node_idx);
         }
     }
 
+    // Keep the selection in node index order, as it determines the order of GetSelectedNodes()
+    // and of the depth bump when the box selection ends.
+    if (editor.SelectedNodes.Indices.size() > 1)
+    {
+        ImQsort(
+            editor.SelectedNodes.Indices.Data,
+            static_cast<size_t>(editor.SelectedNodes.Indices.size()),
+            sizeof(int),
+            CompareIndices);
+    }
+
     // Update link selection
 
-    editor.SelectedLinkIndices.clear();
+    SelectionClear(editor.SelectedLinks);
 
-    // Test for overlap against links
+    // Test for overlap against the links in the grid cells under the box
 
-    for (int link_idx = 0; link_idx < editor.Links.Pool.size(); ++link_idx)
+    SpatialGridQuery(editor.LinkGrid, grid_space_box_rect, candidate_indices);
+    for (int i = 0; i < candidate_indices.size(); ++i)
     {
-        if (editor.Links.InUse[link_idx])
-        {
-            const ImLinkData& link = editor.Links.Pool[link_idx];
+        const int         link_idx = candidate_indices[i];
+        const ImLinkData& link = editor.Links.Pool[link_idx];
 
-            const ImPinData& pin_start = editor.Pins.Pool[link.StartPinIdx];
-            const ImPinData& pin_end = editor.Pins.Pool[link.EndPinIdx];
-            const ImRect&    node_start_rect = editor.Nodes.Pool[pin_start.ParentNodeIdx].Rect;
-            const ImRect&    node_end_rect = editor.Nodes.Pool[pin_end.ParentNodeIdx].Rect;
+        const ImPinData& pin_start = editor.Pins.Pool[link.StartPinIdx];
+        const ImPinData& pin_end = editor.Pins.Pool[link.EndPinIdx];
 
-            const ImVec2 start = GetScreenSpacePinCoordinates(
-                node_start_rect, pin_start.AttributeRect, pin_start.Type);
-            const ImVec2 end =
-                GetScreenSpacePinCoordinates(node_end_rect, pin_end.AttributeRect, pin_end.Type);
+        const ImVec2 start = GetScreenSpacePinCoordinates(editor, pin_start);
+        const ImVec2 end = GetScreenSpacePinCoordinates(editor, pin_end);
 
-            // Test
-            if (RectangleOverlapsLink(box_rect, start, end, pin_start.Type))
-            {
-                editor.SelectedLinkIndices.push_back(link_idx);
-            }
+        // Test
+        if (RectangleOverlapsLink(box_rect, start, end, pin_start.Type))
+        {
+            SelectionAdd(editor.SelectedLinks, link_idx);
         }
     }
+
+    if (editor.SelectedLinks.Indices.size() > 1)
+    {
+        ImQsort(
+            editor.SelectedLinks.Indices.Data,
+            static_cast<size_t>(editor.SelectedLinks.Indices.size()),
+            sizeof(int),
+            CompareIndices);
+    }
 }
 
 void TranslateSelectedNodes(ImNodesEditorContext& editor)
@@ -738,9 +1135,9 @@ void TranslateSelectedNodes(ImNodesEditorContext& editor)
     if (GImNodes->LeftMouseDragging)
     {
         const ImGuiIO& io = ImGui::GetIO();
-        for (int i = 0; i < editor.SelectedNodeIndices.size(); ++i)
+        for (int i = 0; i < editor.SelectedNodes.Indices.size(); ++i)
         {
-            const int   node_idx = editor.SelectedNodeIndices[i];
+            const int   node_idx = editor.SelectedNodes.Indices[i];
             ImNodeData& node = editor.Nodes.Pool[node_idx];
             if (node.Draggable)
             {
@@ -848,31 +1245,48 @@ void ClickInteractionUpdate(ImNodesEditorContext& editor)
 
         if (GImNodes->LeftMouseReleased)
         {
-            ImVector<int>&       depth_stack = editor.NodeDepthOrder;
-            const ImVector<int>& selected_idxs = editor.SelectedNodeIndices;
+            ImVector<int>&     depth_stack = editor.NodeDepthOrder;
+            const ImSelection& selection = editor.SelectedNodes;
 
-            // Bump the selected node indices, in order, to the top of the depth stack.
-            // NOTE: this algorithm has worst case time complexity of O(N^2), if the node selection
-            // is ~ N (due to selected_idxs.contains()).
+            // Bump the selected nodes, in order, to the top of the depth stack. Selected nodes
+            // which are already above every unselected node stay where they are, under the bumped
+            // ones.
 
-            if ((selected_idxs.Size > 0) && (selected_idxs.Size < depth_stack.Size))
+            if ((selection.Indices.Size > 0) && (selection.Indices.Size < depth_stack.Size))
             {
-                int num_moved = 0; // The number of indices moved. Stop after selected_idxs.Size
-                for (int i = 0; i < depth_stack.Size - selected_idxs.Size; ++i)
+                int top = depth_stack.Size;
+                while (top > 0 && SelectionContains(selection, depth_stack[top - 1]))
+                {
+                    --top;
+                }
+
+                ImVector<int> bumped_idxs;
+                int           num_unselected = 0;
+                for (int i = 0; i < top; ++i)
                 {
-                    for (int node_idx = depth_stack[i]; selected_idxs.contains(node_idx);
-                         node_idx = depth_stack[i])
+                    const int node_idx = depth_stack[i];
+                    if (SelectionContains(selection, node_idx))
                     {
-                        depth_stack.erase(depth_stack.begin() + static_cast<size_t>(i));
-                        depth_stack.push_back(node_idx);
-                        ++num_moved;
+                        bumped_idxs.push_back(node_idx);
                     }
-
-                    if (num_moved == selected_idxs.Size)
+                    else
                     {
-                        break;
+                        depth_stack[num_unselected++] = node_idx;
                     }
                 }
+
+                const int num_kept_on_top = depth_stack.Size - top;
+                memmove(
+                    depth_stack.Data + num_unselected,
+                    depth_stack.Data + top,
+                    static_cast<size_t>(num_kept_on_top) * sizeof(int));
+                if (!bumped_idxs.empty())
+                {
+                    memcpy(
+                        depth_stack.Data + num_unselected + num_kept_on_top,
+                        bumped_idxs.Data,
+                        bumped_idxs.size_in_bytes());
+                }
             }
 
             editor.ClickInteraction.Type = ImNodesClickInteractionType_None;
@@ -1045,82 +1459,82 @@ void ClickInteractionUpdate(ImNodesEditorContext& editor)
     }
 }
 
-void ResolveOccludedPins(const ImNodesEditorContext& editor, ImVector<int>& occluded_pin_indices)
+// A pin is occluded if a node above its parent node in the depth stack contains it. Such a node
+// is among `candidate_node_indices` whenever the pin position lies in the queried rectangle.
+bool IsPinOccluded(
+    const ImNodesEditorContext& editor,
+    const ImVector<int>&        candidate_node_indices,
+    const int                   parent_node_idx,
+    const ImVec2&               pin_pos)
 {
-    const ImVector<int>& depth_stack = editor.NodeDepthOrder;
-
-    occluded_pin_indices.resize(0);
+    const ImVector<int>& node_idx_to_depth_idx = GImNodes->NodeIdxToDepthIdx;
+    const int            parent_depth_idx = node_idx_to_depth_idx[parent_node_idx];
 
-    if (depth_stack.Size < 2)
+    for (int i = 0; i < candidate_node_indices.size(); ++i)
     {
-        return;
-    }
-
-    // For each node in the depth stack
-    for (int depth_idx = 0; depth_idx < (depth_stack.Size - 1); ++depth_idx)
-    {
-        const ImNodeData& node_below = editor.Nodes.Pool[depth_stack[depth_idx]];
-
-        // Iterate over the rest of the depth stack to find nodes overlapping the pins
-        for (int next_depth_idx = depth_idx + 1; next_depth_idx < depth_stack.Size;
-             ++next_depth_idx)
+        const int node_idx = candidate_node_indices[i];
+        if (node_idx_to_depth_idx[node_idx] > parent_depth_idx &&
+            editor.Nodes.Pool[node_idx].Rect.Contains(pin_pos))
         {
-            const ImRect& rect_above = editor.Nodes.Pool[depth_stack[next_depth_idx]].Rect;
-
-            // Iterate over each pin
-            for (int idx = 0; idx < node_below.PinIndices.Size; ++idx)
-            {
-                const int     pin_idx = node_below.PinIndices[idx];
-                const ImVec2& pin_pos = editor.Pins.Pool[pin_idx].Pos;
-
-                if (rect_above.Contains(pin_pos))
-                {
-                    occluded_pin_indices.push_back(pin_idx);
-                }
-            }
+            return true;
         }
     }
+
+    return false;
 }
 
-ImOptionalIndex ResolveHoveredPin(
-    const ImObjectPool<ImPinData>& pins,
-    const ImVector<int>&           occluded_pin_indices)
+ImOptionalIndex ResolveHoveredPin(ImNodesEditorContext& editor)
 {
     float           smallest_distance = FLT_MAX;
     ImOptionalIndex pin_idx_with_smallest_distance;
 
-    const float hover_radius_sqr = GImNodes->Style.PinHoverRadius * GImNodes->Style.PinHoverRadius;
+    const float hover_radius = GImNodes->Style.PinHoverRadius;
+    const float hover_radius_sqr = hover_radius * hover_radius;
+
+    // Pins lie on the left or right edge of their parent node, offset by PinOffset, so only the
+    // pins of the nodes in the grid cells around the mouse need to be tested.
+    const ImVec2 reach = ImVec2(ImFabs(GImNodes->Style.PinOffset) + hover_radius, hover_radius);
+    const ImRect query_rect(GImNodes->MousePos - reach, GImNodes->MousePos + reach);
+
+    ImVector<int>& candidate_node_indices = GImNodes->SpatialQueryResults;
+    SpatialGridQuery(
+        editor.NodeGrid, ScreenSpaceToGridSpace(editor, query_rect), candidate_node_indices);
 
-    for (int idx = 0; idx < pins.Pool.Size; ++idx)
+    for (int i = 0; i < candidate_node_indices.size(); ++i)
     {
-        if (!pins.InUse[idx])
-        {
-            continue;
-        }
+        const int         node_idx = candidate_node_indices[i];
+        const ImNodeData& node = editor.Nodes.Pool[node_idx];
 
-        if (occluded_pin_indices.contains(idx))
+        for (int pin_i = 0; pin_i < node.PinIndices.size(); ++pin_i)
         {
-            continue;
-        }
+            const int        pin_idx = node.PinIndices[pin_i];
+            const ImPinData& pin = editor.Pins.Pool[pin_idx];
+            const ImVec2     pin_pos = GetScreenSpacePinCoordinates(editor, pin);
+            const float      distance_sqr = ImLengthSqr(pin_pos - GImNodes->MousePos);
 
-        const ImVec2& pin_pos = pins.Pool[idx].Pos;
-        const float   distance_sqr = ImLengthSqr(pin_pos - GImNodes->MousePos);
+            // TODO: GImNodes->Style.PinHoverRadius needs to be copied into pin data and the
+            // pin-local value used here. This is no longer called in BeginAttribute/EndAttribute
+            // scope and the detected pin might have a different hover radius than what the user
+            // had when calling BeginAttribute/EndAttribute.
+            if (distance_sqr >= hover_radius_sqr || distance_sqr > smallest_distance ||
+                (distance_sqr == smallest_distance &&
+                 pin_idx > pin_idx_with_smallest_distance.Value()))
+            {
+                continue;
+            }
 
-        // TODO: GImNodes->Style.PinHoverRadius needs to be copied into pin data and the pin-local
-        // value used here. This is no longer called in BeginAttribute/EndAttribute scope and the
-        // detected pin might have a different hover radius than what the user had when calling
-        // BeginAttribute/EndAttribute.
-        if (distance_sqr < hover_radius_sqr && distance_sqr < smallest_distance)
-        {
-            smallest_distance = distance_sqr;
-            pin_idx_with_smallest_distance = idx;
+            if (!IsPinOccluded(editor, candidate_node_indices, node_idx, pin_pos))
+            {
+                smallest_distance = distance_sqr;
+                pin_idx_with_smallest_distance = pin_idx;
+            }
         }
     }
 
     return pin_idx_with_smallest_distance;
 }
 
-ImOptionalIndex ResolveHoveredNode(const ImVector<int>& depth_stack)
+ImOptionalIndex ResolveHoveredNode()
 {
     if (GImNodes->NodeIndicesOverlappingWithMouse.size() == 0)
     {
@@ -1138,13 +1552,11 @@ ImOptionalIndex ResolveHoveredNode(const ImVector<int>& depth_stack)
     for (int i = 0; i < GImNodes->NodeIndicesOverlappingWithMouse.size(); ++i)
     {
         const int node_idx = GImNodes->NodeIndicesOverlappingWithMouse[i];
-        for (int depth_idx = 0; depth_idx < depth_stack.size(); ++depth_idx)
+        const int depth_idx = GImNodes->NodeIdxToDepthIdx[node_idx];
+        if (depth_idx > largest_depth_idx)
         {
-            if (depth_stack[depth_idx] == node_idx && (depth_idx > largest_depth_idx))
-            {
-                largest_depth_idx = depth_idx;
-                node_idx_on_top = node_idx;
-            }
+            largest_depth_idx = depth_idx;
+            node_idx_on_top = node_idx;
         }
     }
 
@@ -1152,43 +1564,66 @@ ImOptionalIndex ResolveHoveredNode(const ImVector<int>& depth_stack)
     return ImOptionalIndex(node_idx_on_top);
 }
 
-ImOptionalIndex ResolveHoveredLink(
-    const ImObjectPool<ImLinkData>& links,
-    const ImObjectPool<ImPinData>&  pins)
+ImOptionalIndex ResolveHoveredLink(ImNodesEditorContext& editor)
 {
     float           smallest_distance = FLT_MAX;
     ImOptionalIndex link_idx_with_smallest_distance;
 
+    ImVector<int>& candidate_link_indices = GImNodes->SpatialQueryResults;
+
     // There are two ways a link can be detected as "hovered".
     // 1. The link is within hover distance to the mouse. The closest such link is selected as being
     // hovered over.
     // 2. If the link is connected to the currently hovered pin.
     //
     // The latter is a requirement for link detaching with drag click to work, as both a link and
-    // pin are required to be hovered over for the feature to work.
+    // pin are required to be hovered over for the feature to work. It takes precedence over the
+    // former, and the links connected to the pin are the ones whose bounds contain the pin.
 
-    for (int idx = 0; idx < links.Pool.Size; ++idx)
+    if (GImNodes->HoveredPinIdx.HasValue())
     {
-        if (!links.InUse[idx])
+        const int        hovered_pin_idx = GImNodes->HoveredPinIdx.Value();
+        const ImPinData& hovered_pin = editor.Pins.Pool[hovered_pin_idx];
+        const ImVec2     pin_pos =
+            ScreenSpaceToGridSpace(editor, GetScreenSpacePinCoordinates(editor, hovered_pin));
+        SpatialGridQuery(editor.LinkGrid, ImRect(pin_pos, pin_pos), candidate_link_indices);
+
+        int connected_link_idx = INT_MAX;
+        for (int i = 0; i < candidate_link_indices.size(); ++i)
         {
-            continue;
+            const int         link_idx = candidate_link_indices[i];
+            const ImLinkData& link = editor.Links.Pool[link_idx];
+            if ((link.StartPinIdx == hovered_pin_idx || link.EndPinIdx == hovered_pin_idx) &&
+                link_idx < connected_link_idx)
+            {
+                connected_link_idx = link_idx;
+            }
         }
 
-        const ImLinkData& link = links.Pool[idx];
-        const ImPinData&  start_pin = pins.Pool[link.StartPinIdx];
-        const ImPinData&  end_pin = pins.Pool[link.EndPinIdx];
-
-        if (GImNodes->HoveredPinIdx == link.StartPinIdx ||
-            GImNodes->HoveredPinIdx == link.EndPinIdx)
+        if (connected_link_idx != INT_MAX)
         {
-            return idx;
+            return connected_link_idx;
         }
+    }
+
+    const ImVec2 mouse_pos = ScreenSpaceToGridSpace(editor, GImNodes->MousePos);
+    SpatialGridQuery(editor.LinkGrid, ImRect(mouse_pos, mouse_pos), candidate_link_indices);
+
+    for (int i = 0; i < candidate_link_indices.size(); ++i)
+    {
+        const int         link_idx = candidate_link_indices[i];
+        const ImLinkData& link = editor.Links.Pool[link_idx];
+        const ImPinData&  start_pin = editor.Pins.Pool[link.StartPinIdx];
+        const ImPinData&  end_pin = editor.Pins.Pool[link.EndPinIdx];
 
         // TODO: the calculated CubicBeziers could be cached since we generate them again when
         // rendering the links
 
         const CubicBezier cubic_bezier = GetCubicBezier(
-            start_pin.Pos, end_pin.Pos, start_pin.Type, GImNodes->Style.LinkLineSegmentsPerLength);
+            GetScreenSpacePinCoordinates(editor, start_pin),
+            GetScreenSpacePinCoordinates(editor, end_pin),
+            start_pin.Type,
+            GImNodes->Style.LinkLineSegmentsPerLength);
 
         // The distance test
         {
@@ -1205,10 +1640,13 @@ ImOptionalIndex ResolveHoveredLink(
                 // since we're not calling this function in the same scope as ImNodes::Link(). The
                 // rendered/detected link might have a different hover distance than what the user
                 // had specified when calling Link()
-                if (distance < GImNodes->Style.LinkHoverDistance && distance < smallest_distance)
+                if (distance < GImNodes->Style.LinkHoverDistance &&
+                    (distance < smallest_distance ||
+                     (distance == smallest_distance &&
+                      link_idx < link_idx_with_smallest_distance.Value())))
                 {
                     smallest_distance = distance;
-                    link_idx_with_smallest_distance = idx;
+                    link_idx_with_smallest_distance = link_idx;
                 }
             }
         }
@@ -1269,6 +1707,17 @@ inline ImRect GetNodeTitleRect(const ImNodeData& node)
             ImVec2(0.f, expanded_title_rect.GetHeight()));
 }
 
+// Nodes are culled against the canvas rectangle expanded by this margin, since the node outline and
+// the pins extend past ImNodeData::Rect. Hovering a pin also works slightly outside of it.
+float GetNodeCullingMargin()
+{
+    const ImNodesStyle& style = GImNodes->Style;
+    const float         pin_extent = ImMax(
+        ImMax(style.PinHoverRadius, style.PinCircleRadius),
+        ImMax(style.PinQuadSideLength, style.PinTriangleSideLength));
+    return ImFabs(style.PinOffset) + pin_extent + style.NodeBorderThickness;
+}
+
 void DrawGrid(ImNodesEditorContext& editor, const ImVec2& canvas_size)
 {
     const ImVec2 offset = editor.Panning;
@@ -1458,7 +1907,7 @@ void DrawNode(ImNodesEditorContext& editor, const int node_idx)
     ImU32 node_background = node.ColorStyle.Background;
     ImU32 titlebar_background = node.ColorStyle.Titlebar;
 
-    if (editor.SelectedNodeIndices.contains(node_idx))
+    if (SelectionContains(editor.SelectedNodes, node_idx))
     {
         node_background = node.ColorStyle.BackgroundSelected;
         titlebar_background = node.ColorStyle.TitlebarSelected;
@@ -1535,6 +1984,364 @@ void DrawNode(ImNodesEditorContext& editor, const int node_idx)
     }
 }
 
+// Links which are short on the screen are drawn as a single straight segment, which is the same
+// polyline a one-segment bezier curve produces.
+inline int GetLinkDrawSegments(const CubicBezier& cubic_bezier)
+{
+    const float min_length = GImNodes->Style.LodLinkMinLength;
+    return ImLengthSqr(cubic_bezier.P3 - cubic_bezier.P0) < min_length * min_length
+               ? 1
+               : cubic_bezier.NumSegments;
+}
+
+void DrawLinkCurve(const CubicBezier& cubic_bezier, const ImU32 color, const float thickness)
+{
+#if IMGUI_VERSION_NUM < 18000
+    GImNodes->CanvasDrawList->AddBezierCurve(
+#else
+    GImNodes->CanvasDrawList->AddBezierCubic(
+#endif
+        cubic_bezier.P0,
+        cubic_bezier.P1,
+        cubic_bezier.P2,
+        cubic_bezier.P3,
+        color,
+        thickness,
+        GetLinkDrawSegments(cubic_bezier));
+}
+
+// The links of the editor are drawn in one batch. LinkBatchAddLink() queues the visible links, and
+// LinkBatchEnd() reserves one block of the canvas draw list for all of them, then fills in each
+// link's part of the block, optionally on the user's threads: a link whose mesh is cached copies
+// it, the others are tessellated in place. The output is the same as drawing each link with
+// DrawLinkCurve().
+
+// The number of links filled in by one task
+const int LINK_BATCH_TASK_SIZE = 256;
+
+// The size of the mesh emitted for an open polyline. This mirrors the PrimReserve() counts of
+// ImDrawList::AddPolyline() in imgui_draw.cpp and must be kept in sync with it.
+void GetPolylineMeshSize(
+    const ImDrawList& draw_list,
+    const int         points_count,
+    float             thickness,
+    int* const        vtx_count,
+    int* const        idx_count)
+{
+    const int count = points_count - 1;
+    if (draw_list.Flags & ImDrawListFlags_AntiAliasedLines)
+    {
+        const bool thick_line = thickness > draw_list._FringeScale;
+        thickness = ImMax(thickness, 1.0f);
+        const int   integer_thickness = static_cast<int>(thickness);
+        const float fractional_thickness = thickness - integer_thickness;
+        const bool  use_texture = (draw_list.Flags & ImDrawListFlags_AntiAliasedLinesUseTex) &&
+                                 integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX &&
+                                 fractional_thickness <= 0.00001f && draw_list._FringeScale == 1.0f;
+        *idx_count = use_texture ? count * 6 : (thick_line ? count * 18 : count * 12);
+        *vtx_count =
+            use_texture ? points_count * 2 : (thick_line ? points_count * 4 : points_count * 3);
+    }
+    else
+    {
+        *idx_count = count * 6;
+        *vtx_count = count * 4;
+    }
+}
+
+struct LinkBatchTaskData
+{
+    ImLinkMeshCache*     Cache;
+    const ImVector<int>* Queue;
+    ImDrawList*          CanvasDrawList;
+    ImDrawList* const*   DrawLists;
+};
+
+// Fills in the canvas draw list for one chunk of the queued links. The chunks write to disjoint
+// parts of the reserved block and of the cache, and nothing is allocated, so this can run on any
+// thread.
+void LinkBatchTask(void* task_data, const int task_n)
+{
+    const LinkBatchTaskData& data = *static_cast<const LinkBatchTaskData*>(task_data);
+    ImLinkMeshCache&         cache = *data.Cache;
+    ImDrawList* const        draw_list = data.DrawLists[task_n];
+    const int                begin = task_n * LINK_BATCH_TASK_SIZE;
+    const int                end = ImMin(begin + LINK_BATCH_TASK_SIZE, data.Queue->size());
+
+    for (int i = begin; i < end; ++i)
+    {
+        ImLinkMeshCache::Entry& entry = cache.Entries[(*data.Queue)[i]];
+        ImDrawVert* const vtx_write = data.CanvasDrawList->VtxBuffer.Data + entry.DrawVtxOffset;
+        ImDrawIdx* const  idx_write = data.CanvasDrawList->IdxBuffer.Data + entry.DrawIdxOffset;
+
+        if (entry.MeshGeneration == cache.Generation)
+        {
+            memcpy(
+                vtx_write,
+                cache.VtxBuffer.Data + entry.VtxOffset,
+                static_cast<size_t>(entry.VtxCount) * sizeof(ImDrawVert));
+            const ImDrawIdx* const idx_read = cache.IdxBuffer.Data + entry.IdxOffset;
+            for (int j = 0; j < entry.IdxCount; ++j)
+            {
+                idx_write[j] = static_cast<ImDrawIdx>(entry.DrawVtxIdx + idx_read[j]);
+            }
+            continue;
+        }
+
+        // Point the task's draw list at the link's part of the block, like ImDrawListSplitter
+        // swaps buffers, so that the link is tessellated in place. The draw list never owns it.
+        draw_list->VtxBuffer.Data = vtx_write;
+        draw_list->VtxBuffer.Size = 0;
+        draw_list->VtxBuffer.Capacity = entry.VtxCount;
+        draw_list->IdxBuffer.Data = idx_write;
+        draw_list->IdxBuffer.Size = 0;
+        draw_list->IdxBuffer.Capacity = entry.IdxCount;
+        draw_list->_VtxCurrentIdx = entry.DrawVtxIdx;
+
+        draw_list->PathLineTo(entry.P0);
+        draw_list->PathBezierCubicCurveTo(entry.P1, entry.P2, entry.P3, entry.NumSegments);
+        draw_list->PathStroke(entry.Color, 0, entry.Thickness);
+
+        assert(
+            draw_list->VtxBuffer.Size == entry.VtxCount &&
+            draw_list->IdxBuffer.Size == entry.IdxCount);
+        draw_list->VtxBuffer.Data = NULL;
+        draw_list->VtxBuffer.Size = draw_list->VtxBuffer.Capacity = 0;
+        draw_list->IdxBuffer.Data = NULL;
+        draw_list->IdxBuffer.Size = draw_list->IdxBuffer.Capacity = 0;
+
+        if (entry.StoreMesh)
+        {
+            memcpy(
+                cache.VtxBuffer.Data + entry.VtxOffset,
+                vtx_write,
+                static_cast<size_t>(entry.VtxCount) * sizeof(ImDrawVert));
+            ImDrawIdx* const idx_store = cache.IdxBuffer.Data + entry.IdxOffset;
+            for (int j = 0; j < entry.IdxCount; ++j)
+            {
+                idx_store[j] = static_cast<ImDrawIdx>(idx_write[j] - entry.DrawVtxIdx);
+            }
+            entry.MeshGeneration = cache.Generation;
+        }
+    }
+}
+
+void LinkBatchBegin(ImNodesEditorContext& editor)
+{
+    GImNodes->LinkDrawQueue.resize(0);
+
+    // The meshes depend on the anti-aliasing settings and texture coordinates of the draw list. The
+    // buffers are also dropped when most of them is unused, and refilled as the links stay still.
+    ImLinkMeshCache&                  cache = editor.LinkMeshes;
+    const ImDrawList* const           draw_list = GImNodes->CanvasDrawList;
+    const ImDrawListSharedData* const shared_data = draw_list->_Data;
+    if (cache.DrawListFlags != draw_list->Flags || cache.FringeScale != draw_list->_FringeScale ||
+        cache.TexUvWhitePixel.x != shared_data->TexUvWhitePixel.x ||
+        cache.TexUvWhitePixel.y != shared_data->TexUvWhitePixel.y ||
+        memcmp(cache.TexUvLines, shared_data->TexUvLines, sizeof(cache.TexUvLines)) != 0 ||
+        cache.VtxBuffer.size() > cache.LiveVtxCount * 2)
+    {
+        cache.DrawListFlags = draw_list->Flags;
+        cache.FringeScale = draw_list->_FringeScale;
+        cache.TexUvWhitePixel = shared_data->TexUvWhitePixel;
+        memcpy(cache.TexUvLines, shared_data->TexUvLines, sizeof(cache.TexUvLines));
+        cache.VtxBuffer.resize(0);
+        cache.IdxBuffer.resize(0);
+        ++cache.Generation;
+    }
+}
+
+void LinkBatchAddLink(
+    ImNodesEditorContext& editor,
+    const int             link_idx,
+    const CubicBezier&    cubic_bezier,
+    const ImU32           color,
+    const float           thickness)
+{
+    if ((color & IM_COL32_A_MASK) == 0)
+    {
+        return;
+    }
+
+    ImLinkMeshCache& cache = editor.LinkMeshes;
+    if (link_idx >= cache.Entries.size())
+    {
+        cache.Entries.resize(link_idx + 1, ImLinkMeshCache::Entry());
+    }
+
+    // The inner control points only depend on the end points. A link which changed is tessellated
+    // until it stays the same for two frames, then its mesh is stored.
+    ImLinkMeshCache::Entry& entry = cache.Entries[link_idx];
+    const int               num_segments = GetLinkDrawSegments(cubic_bezier);
+    if (entry.P0.x != cubic_bezier.P0.x || entry.P0.y != cubic_bezier.P0.y ||
+        entry.P3.x != cubic_bezier.P3.x || entry.P3.y != cubic_bezier.P3.y ||
+        entry.NumSegments != num_segments || entry.Color != color || entry.Thickness != thickness)
+    {
+        entry.P0 = cubic_bezier.P0;
+        entry.P1 = cubic_bezier.P1;
+        entry.P2 = cubic_bezier.P2;
+        entry.P3 = cubic_bezier.P3;
+        entry.NumSegments = num_segments;
+        entry.Color = color;
+        entry.Thickness = thickness;
+        entry.MeshGeneration = 0;
+        entry.StoreMesh = false;
+    }
+    else
+    {
+        entry.StoreMesh = entry.MeshGeneration != cache.Generation;
+    }
+    GetPolylineMeshSize(
+        *GImNodes->CanvasDrawList, num_segments + 1, thickness, &entry.VtxCount, &entry.IdxCount);
+
+    GImNodes->LinkDrawQueue.push_back(link_idx);
+}
+
+// Reserves the canvas draw list for the queued links [begin, end), which share a draw command
+void LinkBatchReserve(
+    ImLinkMeshCache& cache,
+    const int        begin,
+    const int        end,
+    const int        vtx_count,
+    const int        idx_count)
+{
+    const ImVector<int>& queue = GImNodes->LinkDrawQueue;
+    ImDrawList* const    draw_list = GImNodes->CanvasDrawList;
+
+    draw_list->PrimReserve(idx_count, vtx_count);
+
+    int          vtx_offset = draw_list->VtxBuffer.size() - vtx_count;
+    int          idx_offset = draw_list->IdxBuffer.size() - idx_count;
+    unsigned int vtx_idx = draw_list->_VtxCurrentIdx;
+    for (int i = begin; i < end; ++i)
+    {
+        ImLinkMeshCache::Entry& entry = cache.Entries[queue[i]];
+        entry.DrawVtxOffset = vtx_offset;
+        entry.DrawIdxOffset = idx_offset;
+        entry.DrawVtxIdx = vtx_idx;
+        vtx_offset += entry.VtxCount;
+        idx_offset += entry.IdxCount;
+        vtx_idx += static_cast<unsigned int>(entry.VtxCount);
+    }
+
+    draw_list->_VtxWritePtr += vtx_count;
+    draw_list->_IdxWritePtr += idx_count;
+    draw_list->_VtxCurrentIdx += static_cast<unsigned int>(vtx_count);
+}
+
+void LinkBatchEnd(ImNodesEditorContext& editor)
+{
+    ImLinkMeshCache&       cache = editor.LinkMeshes;
+    const ImVector<int>&   queue = GImNodes->LinkDrawQueue;
+    ImVector<ImDrawList*>& task_draw_lists = GImNodes->LinkTaskDrawLists;
+    ImDrawList* const      canvas_draw_list = GImNodes->CanvasDrawList;
+
+    if (queue.empty())
+    {
+        cache.LiveVtxCount = 0;
+        return;
+    }
+
+    // Reserve the block. With 16-bit indices, split it where drawing the links one by one would
+    // make PrimReserve() start a new draw command, so that the indices of each part fit.
+    int          run_begin = 0;
+    int          run_vtx_count = 0;
+    int          run_idx_count = 0;
+    unsigned int run_vtx_base = 0;
+    for (int i = 0; i < queue.size(); ++i)
+    {
+        const ImLinkMeshCache::Entry& entry = cache.Entries[queue[i]];
+        if (sizeof(ImDrawIdx) == 2 && run_vtx_count > 0 &&
+            run_vtx_base + run_vtx_count + entry.VtxCount >= (1 << 16))
+        {
+            LinkBatchReserve(cache, run_begin, i, run_vtx_count, run_idx_count);
+            run_begin = i;
+            run_vtx_count = 0;
+            run_idx_count = 0;
+        }
+
+        if (run_vtx_count == 0)
+        {
+            run_vtx_base = canvas_draw_list->_VtxCurrentIdx;
+            if (run_vtx_base + entry.VtxCount >= (1 << 16) &&
+                (canvas_draw_list->Flags & ImDrawListFlags_AllowVtxOffset))
+            {
+                run_vtx_base = 0;
+            }
+        }
+        run_vtx_count += entry.VtxCount;
+        run_idx_count += entry.IdxCount;
+    }
+    LinkBatchReserve(cache, run_begin, queue.size(), run_vtx_count, run_idx_count);
+
+    // Find a slot in the cache for the meshes to store, reusing the entry's slot when it fits
+    int live_vtx_count = 0;
+    for (int i = 0; i < queue.size(); ++i)
+    {
+        ImLinkMeshCache::Entry& entry = cache.Entries[queue[i]];
+        if (entry.StoreMesh &&
+            (entry.SlotGeneration != cache.Generation || entry.VtxCapacity < entry.VtxCount ||
+             entry.IdxCapacity < entry.IdxCount))
+        {
+            entry.SlotGeneration = cache.Generation;
+            entry.VtxOffset = cache.VtxBuffer.size();
+            entry.VtxCapacity = entry.VtxCount;
+            entry.IdxOffset = cache.IdxBuffer.size();
+            entry.IdxCapacity = entry.IdxCount;
+            cache.VtxBuffer.resize(cache.VtxBuffer.size() + entry.VtxCount);
+            cache.IdxBuffer.resize(cache.IdxBuffer.size() + entry.IdxCount);
+        }
+        if (entry.StoreMesh || entry.MeshGeneration == cache.Generation)
+        {
+            live_vtx_count += entry.VtxCapacity;
+        }
+    }
+    cache.LiveVtxCount = live_vtx_count;
+
+    // Each task tessellates in a draw list of its own, which only needs the canvas draw list state
+    // and room for the longest path of the task
+    const int num_tasks = (queue.size() + LINK_BATCH_TASK_SIZE - 1) / LINK_BATCH_TASK_SIZE;
+    while (task_draw_lists.size() < num_tasks)
+    {
+        task_draw_lists.push_back(IM_NEW(ImDrawList)(canvas_draw_list->_Data));
+    }
+
+    for (int task_n = 0; task_n < num_tasks; ++task_n)
+    {
+        ImDrawList* const draw_list = task_draw_lists[task_n];
+        draw_list->_Data = canvas_draw_list->_Data;
+        draw_list->_ResetForNewFrame();
+        draw_list->Flags = canvas_draw_list->Flags & ~ImDrawListFlags_AllowVtxOffset;
+        draw_list->_FringeScale = canvas_draw_list->_FringeScale;
+
+        int       max_points_count = 0;
+        const int end = ImMin((task_n + 1) * LINK_BATCH_TASK_SIZE, queue.size());
+        for (int i = task_n * LINK_BATCH_TASK_SIZE; i < end; ++i)
+        {
+            max_points_count = ImMax(max_points_count, cache.Entries[queue[i]].NumSegments + 1);
+        }
+        draw_list->_Path.reserve(max_points_count);
+    }
+
+    LinkBatchTaskData task_data;
+    task_data.Cache = &cache;
+    task_data.Queue = &queue;
+    task_data.CanvasDrawList = canvas_draw_list;
+    task_data.DrawLists = task_draw_lists.Data;
+    if (GImNodes->Io.ParallelForFn != NULL && num_tasks > 1)
+    {
+        GImNodes->Io.ParallelForFn(
+            GImNodes->Io.ParallelForUserData, num_tasks, LinkBatchTask, &task_data);
+    }
+    else
+    {
+        for (int task_n = 0; task_n < num_tasks; ++task_n)
+        {
+            LinkBatchTask(&task_data, task_n);
+        }
+    }
+}
+
 void DrawLink(ImNodesEditorContext& editor, const int link_idx)
 {
     const ImLinkData& link = editor.Links.Pool[link_idx];
@@ -1567,8 +2374,19 @@ void DrawLink(ImNodesEditorContext& editor, const int link_idx)
         return;
     }
 
+    // Skip tessellating links which are entirely outside of the canvas
+    {
+        ImRect link_rect = GetContainingRectForCubicBezier(cubic_bezier);
+        link_rect.Expand(0.5f * GImNodes->Style.LinkThickness);
+        if (!GImNodes->CanvasRectScreenSpace.Overlaps(link_rect))
+        {
+            ++GImNodes->CulledLinkCount;
+            return;
+        }
+    }
+
     ImU32 link_color = link.ColorStyle.Base;
-    if (editor.SelectedLinkIndices.contains(link_idx))
+    if (SelectionContains(editor.SelectedLinks, link_idx))
     {
         link_color = link.ColorStyle.Selected;
     }
@@ -1577,18 +2395,7 @@ void DrawLink(ImNodesEditorContext& editor, const int link_idx)
         link_color = link.ColorStyle.Hovered;
     }
 
-#if IMGUI_VERSION_NUM < 18000
-    GImNodes->CanvasDrawList->AddBezierCurve(
-#else
-    GImNodes->CanvasDrawList->AddBezierCubic(
-#endif
-        cubic_bezier.P0,
-        cubic_bezier.P1,
-        cubic_bezier.P2,
-        cubic_bezier.P3,
-        link_color,
-        GImNodes->Style.LinkThickness,
-        cubic_bezier.NumSegments);
+    LinkBatchAddLink(editor, link_idx, cubic_bezier, link_color, GImNodes->Style.LinkThickness);
 }
 
 void BeginPinAttribute(
@@ -1658,6 +2465,9 @@ void Initialize(ImNodesContext* context)
     context->CurrentPinIdx = INT_MAX;
     context->CurrentNodeIdx = INT_MAX;
 
+    context->CulledNodeCount = 0;
+    context->CulledLinkCount = 0;
+
     context->DefaultEditorCtx = EditorContextCreate();
     EditorContextSet(GImNodes->DefaultEditorCtx);
 
@@ -1667,7 +2477,14 @@ void Initialize(ImNodesContext* context)
     StyleColorsDark();
 }
 
-void Shutdown(ImNodesContext* ctx) { EditorContextFree(ctx->DefaultEditorCtx); }
+void Shutdown(ImNodesContext* ctx)
+{
+    EditorContextFree(ctx->DefaultEditorCtx);
+    for (int i = 0; i < ctx->LinkTaskDrawLists.size(); ++i)
+    {
+        IM_DELETE(ctx->LinkTaskDrawLists[i]);
+    }
+}
 
 // [SECTION] minimap
 
@@ -1744,6 +2561,11 @@ static void MiniMapDrawNode(
 
     const ImVec2 mini_map_node_max(mini_map_node_min + mini_map_node_size);
 
+    if (!GImNodes->MiniMapRectScreenSpace.Overlaps(ImRect(mini_map_node_min, mini_map_node_max)))
+    {
+        return;
+    }
+
     // Round to near whole pixel value for corner-rounding to prevent visual glitches
     const float mini_map_node_rounding = floorf(node.LayoutStyle.CornerRounding * scaling);
 
@@ -1765,7 +2587,7 @@ static void MiniMapDrawNode(
         GImNodes->MiniMapRectSnappingOffset =
             editor_center - (node.Rect.Min + node.Rect.Max) * 0.5f;
     }
-    else if (editor.SelectedNodeIndices.contains(node_idx))
+    else if (SelectionContains(editor.SelectedNodes, node_idx))
     {
         mini_map_node_background = GImNodes->Style.Colors[ImNodesCol_MiniMapNodeBackgroundSelected];
     }
@@ -1774,6 +2596,14 @@ static void MiniMapDrawNode(
         mini_map_node_background = GImNodes->Style.Colors[ImNodesCol_MiniMapNodeBackground];
     }
 
+    // Nodes too small to show their rounding and outline are drawn as a plain rectangle
+    if (ImMin(mini_map_node_size.x, mini_map_node_size.y) < GImNodes->Style.LodNodeMinSize)
+    {
+        GImNodes->CanvasDrawList->AddRectFilled(
+            mini_map_node_min, mini_map_node_max, mini_map_node_background);
+        return;
+    }
+
     const ImU32 mini_map_node_outline = GImNodes->Style.Colors[ImNodesCol_MiniMapNodeOutline];
 
     GImNodes->CanvasDrawList->AddRectFilled(
@@ -1794,11 +2624,12 @@ static void MiniMapDrawLink(
     const ImPinData&  start_pin = editor.Pins.Pool[link.StartPinIdx];
     const ImPinData&  end_pin = editor.Pins.Pool[link.EndPinIdx];
 
+    // Tessellate the link from its length in the mini-map, not its length in the editor
     const CubicBezier cubic_bezier = GetCubicBezier(
         (start_pin.Pos - editor_center) * scaling + mini_map_center,
         (end_pin.Pos - editor_center) * scaling + mini_map_center,
         start_pin.Type,
-        GImNodes->Style.LinkLineSegmentsPerLength / scaling);
+        GImNodes->Style.LinkLineSegmentsPerLength);
 
     // It's possible for a link to be deleted in begin_link_interaction. A user
     // may detach a link, resulting in the link wire snapping to the mouse
@@ -1810,23 +2641,22 @@ static void MiniMapDrawLink(
         return;
     }
 
+    const float link_thickness = GImNodes->Style.LinkThickness * scaling;
+    {
+        ImRect link_rect = GetContainingRectForCubicBezier(cubic_bezier);
+        link_rect.Expand(0.5f * link_thickness);
+        if (!GImNodes->MiniMapRectScreenSpace.Overlaps(link_rect))
+        {
+            return;
+        }
+    }
+
     const ImU32 link_color =
         GImNodes->Style.Colors
-            [editor.SelectedLinkIndices.contains(link_idx) ? ImNodesCol_MiniMapLinkSelected
-                                                           : ImNodesCol_MiniMapLink];
+            [SelectionContains(editor.SelectedLinks, link_idx) ? ImNodesCol_MiniMapLinkSelected
+                                                               : ImNodesCol_MiniMapLink];
 
-#if IMGUI_VERSION_NUM < 18000
-    GImNodes->CanvasDrawList->AddBezierCurve(
-#else
-    GImNodes->CanvasDrawList->AddBezierCubic(
-#endif
-        cubic_bezier.P0,
-        cubic_bezier.P1,
-        cubic_bezier.P2,
-        cubic_bezier.P3,
-        link_color,
-        GImNodes->Style.LinkThickness * scaling,
-        cubic_bezier.NumSegments);
+    DrawLinkCurve(cubic_bezier, link_color, link_thickness);
 }
 
 static void MiniMapUpdate()
@@ -1872,21 +2702,41 @@ static void MiniMapUpdate()
     // Get zoom scaling (0, 1]
     const float scaling = GImNodes->MiniMapZoom;
 
+    // Only the nodes and links in the part of the editor shown by the mini-map are drawn. The
+    // candidates are sorted to keep drawing them in pool order.
+    SpatialGridsUpdate(editor);
+    const ImRect grid_space_view_rect = ScreenSpaceToGridSpace(
+        editor,
+        ImRect(
+            (mini_map_rect.Min - mini_map_center) / scaling + editor_center,
+            (mini_map_rect.Max - mini_map_center) / scaling + editor_center));
+    ImVector<int>& candidate_indices = GImNodes->SpatialQueryResults;
+
     // Draw links first so they appear under nodes, and we can use the same draw channel
-    for (int link_idx = 0; link_idx < editor.Links.Pool.size(); ++link_idx)
     {
-        if (editor.Links.InUse[link_idx])
-        {
-            MiniMapDrawLink(editor, link_idx, editor_center, mini_map_center, scaling);
-        }
+        ImRect grid_space_link_view_rect = grid_space_view_rect;
+        grid_space_link_view_rect.Expand(0.5f * GImNodes->Style.LinkThickness);
+        SpatialGridQuery(editor.LinkGrid, grid_space_link_view_rect, candidate_indices);
+    }
+    ImQsort(
+        candidate_indices.Data,
+        static_cast<size_t>(candidate_indices.Size),
+        sizeof(int),
+        CompareIndices);
+    for (int i = 0; i < candidate_indices.Size; ++i)
+    {
+        MiniMapDrawLink(editor, candidate_indices[i], editor_center, mini_map_center, scaling);
     }
 
-    for (int node_idx = 0; node_idx < editor.Nodes.Pool.size(); ++node_idx)
+    SpatialGridQuery(editor.NodeGrid, grid_space_view_rect, candidate_indices);
+    ImQsort(
+        candidate_indices.Data,
+        static_cast<size_t>(candidate_indices.Size),
+        sizeof(int),
+        CompareIndices);
+    for (int i = 0; i < candidate_indices.Size; ++i)
     {
-        if (editor.Nodes.InUse[node_idx])
-        {
-            MiniMapDrawNode(editor, node_idx, editor_center, mini_map_center, scaling);
-        }
+        MiniMapDrawNode(editor, candidate_indices[i], editor_center, mini_map_center, scaling);
     }
 
     // Have to pop mini-map clip rect
@@ -1911,7 +2761,7 @@ ImNodesIO::LinkDetachWithModifierClick::LinkDetachWithModifierClick() : Modifier
 
 ImNodesIO::ImNodesIO()
     : EmulateThreeButtonMouse(), LinkDetachWithModifierClick(),
-      AltMouseButton(ImGuiMouseButton_Middle)
+      AltMouseButton(ImGuiMouseButton_Middle), ParallelForFn(NULL), ParallelForUserData(NULL)
 {
 }
 
@@ -1920,7 +2770,7 @@ ImNodesStyle::ImNodesStyle()
       NodePaddingVertical(8.f), NodeBorderThickness(1.f), LinkThickness(3.f),
       LinkLineSegmentsPerLength(0.1f), LinkHoverDistance(10.f), PinCircleRadius(4.f),
       PinQuadSideLength(7.f), PinTriangleSideLength(9.5), PinLineThickness(1.f),
-      PinHoverRadius(10.f), PinOffset(0.f),
+      PinHoverRadius(10.f), PinOffset(0.f), LodNodeMinSize(4.f), LodLinkMinLength(8.f),
       Flags(ImNodesStyleFlags_NodeOutline | ImNodesStyleFlags_GridLines), Colors()
 {
 }
@@ -2189,39 +3039,60 @@ void EndNodeEditor()
 
     if (MouseInCanvas() && !IsMiniMapHovered())
     {
-        // Pins needs some special care. We need to check the depth stack to see which pins are
-        // being occluded by other nodes.
-        ResolveOccludedPins(editor, GImNodes->OccludedPinIndices);
+        // Hit-testing uses the node rectangles and pin positions submitted this frame, through
+        // the grids. Pins need some special care: a pin is occluded by the nodes above its parent
+        // node in the depth stack.
+        SpatialGridsUpdate(editor);
+        UpdateNodeDepthIndices(editor);
 
-        GImNodes->HoveredPinIdx = ResolveHoveredPin(editor.Pins, GImNodes->OccludedPinIndices);
+        GImNodes->HoveredPinIdx = ResolveHoveredPin(editor);
 
         if (!GImNodes->HoveredPinIdx.HasValue())
         {
             // Resolve which node is actually on top and being hovered using the depth stack.
-            GImNodes->HoveredNodeIdx = ResolveHoveredNode(editor.NodeDepthOrder);
+            GImNodes->HoveredNodeIdx = ResolveHoveredNode();
         }
 
         // We don't need to check the depth stack for links. If a node occludes a link and is being
         // hovered, then we would not be able to detect the link anyway.
         if (!GImNodes->HoveredNodeIdx.HasValue())
         {
-            GImNodes->HoveredLinkIdx = ResolveHoveredLink(editor.Links, editor.Pins);
+            GImNodes->HoveredLinkIdx = ResolveHoveredLink(editor);
         }
     }
 
+    GImNodes->CulledNodeCount = 0;
+    GImNodes->CulledLinkCount = 0;
+
     for (int node_idx = 0; node_idx < editor.Nodes.Pool.size(); ++node_idx)
     {
-        if (editor.Nodes.InUse[node_idx])
+        if (!editor.Nodes.InUse[node_idx])
+        {
+            continue;
+        }
+
+        const ImNodeData& node = editor.Nodes.Pool[node_idx];
+        if (node.Culled)
         {
-            DrawListActivateNodeBackground(node_idx);
-            DrawNode(editor, node_idx);
+            // Links and link creation still need the pin positions of offscreen nodes
+            for (int i = 0; i < node.PinIndices.size(); ++i)
+            {
+                ImPinData& pin = editor.Pins.Pool[node.PinIndices[i]];
+                pin.Pos = GetScreenSpacePinCoordinates(editor, pin);
+            }
+            ++GImNodes->CulledNodeCount;
+            continue;
         }
+
+        DrawListActivateNodeBackground(node_idx);
+        DrawNode(editor, node_idx);
     }
 
     // In order to render the links underneath the nodes, we want to first select the bottom draw
     // channel.
     GImNodes->CanvasDrawList->ChannelsSetCurrent(0);
 
+    LinkBatchBegin(editor);
     for (int link_idx = 0; link_idx < editor.Links.Pool.size(); ++link_idx)
     {
         if (editor.Links.InUse[link_idx])
@@ -2229,6 +3100,7 @@ void EndNodeEditor()
             DrawLink(editor, link_idx);
         }
     }
+    LinkBatchEnd(editor);
 
     // Render the click interaction UI elements (partial links, box selector) on top of everything
     // else.
@@ -2256,7 +3128,7 @@ void EndNodeEditor()
     ObjectPoolUpdate(editor.Nodes);
     ObjectPoolUpdate(editor.Pins);
 
-    DrawListSortChannelsByDepth(editor.NodeDepthOrder);
+    DrawListSortChannelsByDepth(editor);
 
     // After the links have been rendered, the link pool can be updated as well.
     ObjectPoolUpdate(editor.Links);
@@ -2330,8 +3202,25 @@ void BeginNode(const int node_id)
     // ImGui::SetCursorScreenPos to set the screen space coordinates directly.
     ImGui::SetCursorPos(GridSpaceToEditorSpace(editor, GetNodeTitleBarOrigin(node)));
 
-    DrawListAddNode(node_idx);
-    DrawListActivateCurrentNodeForeground();
+    // Nodes which would be entirely outside of the canvas with last frame's size don't get draw
+    // channels. ImGui clips away most of their content, and what's left goes to the canvas channel.
+    {
+        const ImVec2 node_screen_space_pos = GridSpaceToScreenSpace(editor, node.Origin);
+        ImRect predicted_rect(node_screen_space_pos, node_screen_space_pos + node.Rect.GetSize());
+        predicted_rect.Expand(GetNodeCullingMargin());
+        node.Culled = node.Rect.GetWidth() > 0.f &&
+                      !GImNodes->CanvasRectScreenSpace.Overlaps(predicted_rect);
+    }
+
+    if (node.Culled)
+    {
+        GImNodes->CanvasDrawList->ChannelsSetCurrent(0);
+    }
+    else
+    {
+        DrawListAddNode(node_idx);
+        DrawListActivateCurrentNodeForeground();
+    }
 
     ImGui::PushID(node.Id);
     ImGui::BeginGroup();
@@ -2352,6 +3241,20 @@ void EndNode()
     node.Rect = GetItemRect();
     node.Rect.Expand(node.LayoutStyle.Padding);
 
+    // The node was culled in BeginNode, but its size changed and it's now in view. It still needs
+    // draw channels for its background and pins. Its content was already drawn to the canvas
+    // channel, below the node background, which resolves itself in the next frame.
+    if (node.Culled)
+    {
+        ImRect culling_rect = node.Rect;
+        culling_rect.Expand(GetNodeCullingMargin());
+        if (GImNodes->CanvasRectScreenSpace.Overlaps(culling_rect))
+        {
+            node.Culled = false;
+            DrawListAddNode(GImNodes->CurrentNodeIdx);
+        }
+    }
+
     if (node.Rect.Contains(GImNodes->MousePos))
     {
         GImNodes->NodeIndicesOverlappingWithMouse.push_back(GImNodes->CurrentNodeIdx);
@@ -2535,6 +3438,12 @@ float& LookupStyleVar(const ImNodesStyleVar item)
     case ImNodesStyleVar_PinOffset:
         style_var = &GImNodes->Style.PinOffset;
         break;
+    case ImNodesStyleVar_LodNodeMinSize:
+        style_var = &GImNodes->Style.LodNodeMinSize;
+        break;
+    case ImNodesStyleVar_LodLinkMinLength:
+        style_var = &GImNodes->Style.LodLinkMinLength;
+        break;
     default:
         assert(!"Invalid StyleVar value!");
     }
@@ -2661,14 +3570,14 @@ int NumSelectedNodes()
 {
     assert(GImNodes->CurrentScope == ImNodesScope_None);
     const ImNodesEditorContext& editor = EditorContextGet();
-    return editor.SelectedNodeIndices.size();
+    return editor.SelectedNodes.Indices.size();
 }
 
 int NumSelectedLinks()
 {
     assert(GImNodes->CurrentScope == ImNodesScope_None);
     const ImNodesEditorContext& editor = EditorContextGet();
-    return editor.SelectedLinkIndices.size();
+    return editor.SelectedLinks.Indices.size();
 }
 
 void GetSelectedNodes(int* node_ids)
@@ -2676,9 +3585,9 @@ void GetSelectedNodes(int* node_ids)
     assert(node_ids != NULL);
 
     const ImNodesEditorContext& editor = EditorContextGet();
-    for (int i = 0; i < editor.SelectedNodeIndices.size(); ++i)
+    for (int i = 0; i < editor.SelectedNodes.Indices.size(); ++i)
     {
-        const int node_idx = editor.SelectedNodeIndices[i];
+        const int node_idx = editor.SelectedNodes.Indices[i];
         node_ids[i] = editor.Nodes.Pool[node_idx].Id;
     }
 }
@@ -2688,9 +3597,9 @@ void GetSelectedLinks(int* link_ids)
     assert(link_ids != NULL);
 
     const ImNodesEditorContext& editor = EditorContextGet();
-    for (int i = 0; i < editor.SelectedLinkIndices.size(); ++i)
+    for (int i = 0; i < editor.SelectedLinks.Indices.size(); ++i)
     {
-        const int link_idx = editor.SelectedLinkIndices[i];
+        const int link_idx = editor.SelectedLinks.Indices[i];
         link_ids[i] = editor.Links.Pool[link_idx].Id;
     }
 }
@@ -2698,13 +3607,25 @@ void GetSelectedLinks(int* link_ids)
 void ClearNodeSelection()
 {
     ImNodesEditorContext& editor = EditorContextGet();
-    editor.SelectedNodeIndices.clear();
+    SelectionClear(editor.SelectedNodes);
 }
 
 void ClearLinkSelection()
 {
     ImNodesEditorContext& editor = EditorContextGet();
-    editor.SelectedLinkIndices.clear();
+    SelectionClear(editor.SelectedLinks);
+}
+
+int NumCulledNodes()
+{
+    assert(GImNodes->CurrentScope == ImNodesScope_None);
+    return GImNodes->CulledNodeCount;
+}
+
+int NumCulledLinks()
+{
+    assert(GImNodes->CurrentScope == ImNodesScope_None);
+    return GImNodes->CulledLinkCount;
 }
 
 bool IsAttributeActive()
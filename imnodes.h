@@ -9,6 +9,11 @@ typedef int ImNodesPinShape;        // -> enum ImNodesPinShape_
 typedef int ImNodesAttributeFlags;  // -> enum ImNodesAttributeFlags_
 typedef int ImNodesMiniMapLocation; // -> enum ImNodesMiniMapLocation_
 
+// Function signatures for ImNodesIO::ParallelForFn
+typedef void (*ImNodesTaskFunc)(void* task_data, int task_n);
+typedef void (*ImNodesParallelForFunc)(
+    void* user_data, int tasks_count, ImNodesTaskFunc task_func, void* task_data);
+
 enum ImNodesCol_
 {
     ImNodesCol_NodeBackground = 0,
@@ -55,7 +60,9 @@ enum ImNodesStyleVar_
     ImNodesStyleVar_PinTriangleSideLength,
     ImNodesStyleVar_PinLineThickness,
     ImNodesStyleVar_PinHoverRadius,
-    ImNodesStyleVar_PinOffset
+    ImNodesStyleVar_PinOffset,
+    ImNodesStyleVar_LodNodeMinSize,
+    ImNodesStyleVar_LodLinkMinLength
 };
 
 enum ImNodesStyleFlags_
@@ -125,6 +132,13 @@ struct ImNodesIO
     // Set based on ImGuiMouseButton values
     int AltMouseButton;
 
+    // Optional: build the link meshes on your own threads, one task per 256 visible links. Set to
+    // NULL by default. The function must call task_func(task_data, n) once for every n in
+    // [0, tasks_count), from any thread, and return when all the calls have completed. The output
+    // is identical to building the meshes on the calling thread.
+    ImNodesParallelForFunc ParallelForFn;
+    void*                  ParallelForUserData;
+
     ImNodesIO();
 };
 
@@ -161,6 +175,16 @@ struct ImNodesStyle
     // Offsets the pins' positions from the edge of the node to the outside of the node.
     float PinOffset;
 
+    // The following variables control the level of detail used for objects which are small on the
+    // screen, such as in a zoomed out mini-map.
+
+    // Nodes whose width or height is smaller than this many pixels are drawn as a plain filled
+    // rectangle, without corner rounding or outline.
+    float LodNodeMinSize;
+    // Links whose end points are closer than this many pixels are drawn as a straight line segment
+    // instead of a curve. Longer links are tessellated from their length on the screen.
+    float LodLinkMinLength;
+
     // By default, ImNodesStyleFlags_NodeOutline and ImNodesStyleFlags_Gridlines are enabled.
     ImNodesStyleFlags Flags;
     // Set these mid-frame using Push/PopColorStyle. You can index this color array with with a
@@ -325,6 +349,11 @@ void GetSelectedLinks(int* link_ids);
 void ClearNodeSelection();
 void ClearLinkSelection();
 
+// The number of nodes/links which were entirely outside of the canvas, and therefore skipped when
+// rendering. Use after calling EndNodeEditor().
+int NumCulledNodes();
+int NumCulledLinks();
+
 // Was the previous attribute active? This will continuously return true while the left mouse button
 // is being pressed over the UI content of the attribute.
 bool IsAttributeActive();
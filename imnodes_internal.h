@@ -13,6 +13,7 @@
 // [SECTION] internal data structures
 // [SECTION] global and editor context structs
 // [SECTION] object pool implementation
+// [SECTION] selection implementation
 
 struct ImNodesContext;
 
@@ -92,6 +93,17 @@ struct ImObjectPool
     ImObjectPool() : Pool(), InUse(), FreeList(), IdMap() {}
 };
 
+// The selected objects of an object pool. Indices holds the selection in the order reported by
+// GetSelectedNodes()/GetSelectedLinks(), and Flags marks each selected pool index so that testing
+// whether an object is selected doesn't need to search Indices.
+struct ImSelection
+{
+    ImVector<int>  Indices;
+    ImVector<bool> Flags; // Indexed by pool index, grown on demand
+
+    ImSelection() : Indices(), Flags() {}
+};
+
 // Emulates std::optional<int> using the sentinel value `INVALID_INDEX`.
 struct ImOptionalIndex
 {
@@ -154,11 +166,12 @@ struct ImNodeData
 
     ImVector<int> PinIndices;
     bool          Draggable;
+    bool          Culled; // Outside of the canvas this frame: not drawn, and has no draw channels
 
     ImNodeData(const int node_id)
         : Id(node_id), Origin(100.0f, 100.0f), TitleBarContentRect(),
           Rect(ImVec2(0.0f, 0.0f), ImVec2(0.0f, 0.0f)), ColorStyle(), LayoutStyle(), PinIndices(),
-          Draggable(true)
+          Draggable(true), Culled(false)
     {
     }
 
@@ -220,6 +233,101 @@ struct ImClickInteractionState
     ImClickInteractionState() : Type(ImNodesClickInteractionType_None) {}
 };
 
+// Uniform grid over the grid-space bounding rectangles of objects (nodes or links), used to find
+// the objects near the mouse or inside the box selector without testing every object. The grid is
+// updated incrementally: an object is only moved between cells when the range of cells it overlaps
+// changes, which is independent of panning since the cells are in grid space.
+struct ImSpatialGrid
+{
+    struct Cell
+    {
+        int X, Y;
+        int FirstEntry; // -1 if the cell is empty, -2 if the hash table slot is unused
+    };
+
+    struct Entry
+    {
+        int ObjectIdx;
+        int NextEntry;
+    };
+
+    struct CellRange
+    {
+        int MinX, MinY, MaxX, MaxY; // MinX > MaxX if the object is not in the grid
+    };
+
+    float               CellSize;
+    ImVector<Cell>      Cells; // Open addressing hash table, the size is a power of two
+    int                 CellsUsed;
+    ImVector<Entry>     Entries;
+    int                 FreeEntry;
+    ImVector<CellRange> ObjectCells;  // Indexed by object index
+    ImVector<int>       LargeObjects; // Objects overlapping too many cells, tested by every query
+    ImVector<int>       ObjectQueryMarks;
+    int                 QueryMark;
+
+    ImSpatialGrid()
+        : CellSize(128.f), Cells(), CellsUsed(0), Entries(), FreeEntry(-1), ObjectCells(),
+          LargeObjects(), ObjectQueryMarks(), QueryMark(0)
+    {
+    }
+};
+
+// The meshes of the links whose curve, color and thickness didn't change between two frames. Such
+// a link copies its mesh from here instead of being tessellated again. The other links are
+// tessellated every frame, as storing their mesh would only be a cost.
+struct ImLinkMeshCache
+{
+    struct Entry
+    {
+        // The link's curve when it was last drawn
+        ImVec2 P0, P1, P2, P3;
+        int    NumSegments;
+        ImU32  Color;
+        float  Thickness;
+        int    VtxCount, IdxCount; // The size of the curve's mesh
+
+        // The entry's slot in the buffers is current if SlotGeneration equals the cache's
+        // Generation, and holds the curve's mesh if MeshGeneration does too. Indices are relative
+        // to the first vertex of the slot.
+        int SlotGeneration;
+        int MeshGeneration;
+        int VtxOffset, VtxCapacity;
+        int IdxOffset, IdxCapacity;
+
+        // The current frame: where the mesh goes in the canvas draw list, and whether it is stored
+        bool         StoreMesh;
+        int          DrawVtxOffset, DrawIdxOffset;
+        unsigned int DrawVtxIdx;
+
+        Entry()
+            : P0(), P1(), P2(), P3(), NumSegments(0), Color(0), Thickness(0.f), VtxCount(0),
+              IdxCount(0), SlotGeneration(0), MeshGeneration(0), VtxOffset(0), VtxCapacity(0),
+              IdxOffset(0), IdxCapacity(0), StoreMesh(false), DrawVtxOffset(0), DrawIdxOffset(0),
+              DrawVtxIdx(0)
+        {
+        }
+    };
+
+    ImVector<Entry>      Entries; // Indexed by link pool index
+    ImVector<ImDrawVert> VtxBuffer;
+    ImVector<ImDrawIdx>  IdxBuffer;
+    int                  Generation; // Starts at 1, so that new entries are never current
+    int                  LiveVtxCount; // The size of the slots used by the last frame
+
+    // The draw list state the meshes were tessellated with
+    ImDrawListFlags DrawListFlags;
+    float           FringeScale;
+    ImVec2          TexUvWhitePixel;
+    ImVec4          TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+
+    ImLinkMeshCache()
+        : Entries(), VtxBuffer(), IdxBuffer(), Generation(1), LiveVtxCount(0), DrawListFlags(0),
+          FringeScale(0.f), TexUvWhitePixel(), TexUvLines()
+    {
+    }
+};
+
 struct ImNodesColElement
 {
     ImU32      Color;
@@ -252,14 +360,21 @@ struct ImNodesEditorContext
     // ui related fields
     ImVec2 Panning;
 
-    ImVector<int> SelectedNodeIndices;
-    ImVector<int> SelectedLinkIndices;
+    ImSelection SelectedNodes;
+    ImSelection SelectedLinks;
 
     ImClickInteractionState ClickInteraction;
 
+    // Hit-testing acceleration, indexed by node and link pool indices
+    ImSpatialGrid NodeGrid;
+    ImSpatialGrid LinkGrid;
+    int           SpatialGridsFrame; // ImGui frame count of the last grid update
+
+    ImLinkMeshCache LinkMeshes;
+
     ImNodesEditorContext()
-        : Nodes(), Pins(), Links(), Panning(0.f, 0.f), SelectedNodeIndices(), SelectedLinkIndices(),
-          ClickInteraction()
+        : Nodes(), Pins(), Links(), Panning(0.f, 0.f), SelectedNodes(), SelectedLinks(),
+          ClickInteraction(), NodeGrid(), LinkGrid(), SpatialGridsFrame(-1), LinkMeshes()
     {
     }
 };
@@ -270,11 +385,22 @@ struct ImNodesContext
     ImNodesEditorContext* EditorCtx;
 
     // Canvas draw list and helper state
-    ImDrawList*   CanvasDrawList;
-    ImGuiStorage  NodeIdxToSubmissionIdx;
-    ImVector<int> NodeIdxSubmissionOrder;
-    ImVector<int> NodeIndicesOverlappingWithMouse;
-    ImVector<int> OccludedPinIndices;
+    ImDrawList*             CanvasDrawList;
+    ImGuiStorage            NodeIdxToSubmissionIdx;
+    ImVector<int>           NodeIdxSubmissionOrder;
+    ImVector<ImDrawChannel> NodeChannelsScratch; // Doesn't own the channels' memory
+    ImVector<int>           NodeIndicesOverlappingWithMouse;
+    ImVector<int>           NodeIdxToDepthIdx;
+    ImVector<int>           SpatialQueryResults;
+    ImVector<int>           VisibleNodeDepthOrder;
+
+    // Batched link rendering, see LinkBatchEnd()
+    ImVector<int>         LinkDrawQueue;
+    ImVector<ImDrawList*> LinkTaskDrawLists; // One per task, owned
+
+    // View culling counters of the current frame
+    int CulledNodeCount;
+    int CulledLinkCount;
 
     // Canvas extents
     ImVec2 CanvasOriginScreenSpace;
@@ -480,4 +606,33 @@ static inline T& ObjectPoolFindOrCreateObject(ImObjectPool<T>& objects, const in
     const int index = ObjectPoolFindOrCreateIndex(objects, id);
     return objects.Pool[index];
 }
+
+// [SECTION] selection implementation
+
+static inline bool SelectionContains(const ImSelection& selection, const int idx)
+{
+    return idx < selection.Flags.size() && selection.Flags[idx];
+}
+
+// The caller is responsible for not adding an index twice, and for the order of the indices.
+static inline void SelectionAdd(ImSelection& selection, const int idx)
+{
+    if (idx >= selection.Flags.size())
+    {
+        selection.Flags.resize(idx + 1, false);
+    }
+    assert(!selection.Flags[idx]);
+    selection.Flags[idx] = true;
+    selection.Indices.push_back(idx);
+}
+
+// Only touches the flags of the selected indices, so clearing costs O(selection size).
+static inline void SelectionClear(ImSelection& selection)
+{
+    for (int i = 0; i < selection.Indices.size(); ++i)
+    {
+        selection.Flags[selection.Indices[i]] = false;
+    }
+    selection.Indices.clear();
+}
 } // namespace ImNodes
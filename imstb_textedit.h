@@ -2,6 +2,7 @@
 // This is a slightly modified version of stb_textedit.h 1.13.
 // Those changes would need to be pushed into nothings/stb:
 // - Fix in stb_textedit_discard_redo (see https://github.com/nothings/stb/issues/321)
+// - Optional STB_TEXTEDIT_FINDROWBYINDEX/STB_TEXTEDIT_FINDROWBYY handlers, so a client with a line index doesn't lay out every row above the cursor
 // Grep for [DEAR IMGUI] to find the changes.
 
 // stb_textedit.h - v1.13  - public domain - Sean Barrett
@@ -165,6 +166,10 @@
 //                                          required for default WORDLEFT/WORDRIGHT handlers
 //    STB_TEXTEDIT_MOVEWORDLEFT(obj,i)   custom handler for WORDLEFT, returns index to move cursor to
 //    STB_TEXTEDIT_MOVEWORDRIGHT(obj,i)  custom handler for WORDRIGHT, returns index to move cursor to
+//    STB_TEXTEDIT_FINDROWBYINDEX(obj,i,&first,&prev_first,&y)  [DEAR IMGUI] custom handler to locate the row containing character i:
+//                                          outputs its first char, first char of the previous row and its y position
+//    STB_TEXTEDIT_FINDROWBYY(obj,y)     [DEAR IMGUI] custom handler returning the first char of the row straddling 'y',
+//                                          or STRINGLEN if 'y' is below all rows
 //    STB_TEXTEDIT_K_WORDLEFT            keyboard input to move cursor left one word // e.g. ctrl-LEFT
 //    STB_TEXTEDIT_K_WORDRIGHT           keyboard input to move cursor right one word // e.g. ctrl-RIGHT
 //    STB_TEXTEDIT_K_LINESTART2          secondary keyboard input to move cursor to start of line
@@ -406,6 +411,18 @@ static int stb_text_locate_coord(STB_TEXTEDIT_STRING *str, float x, float y)
    r.ymin = r.ymax = 0;
    r.num_chars = 0;
 
+#ifdef STB_TEXTEDIT_FINDROWBYY
+   // [DEAR IMGUI] find the row that straddles 'y' with the client's row index
+   if (n > 0) {
+      i = STB_TEXTEDIT_FINDROWBYY(str, y);
+      if (i < n) {
+         STB_TEXTEDIT_LAYOUTROW(&r, str, i);
+         if (i == 0 && y < r.ymin)
+            return 0;
+      }
+   }
+   (void)base_y;
+#else
    // search rows to find one that straddles 'y'
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -421,6 +438,7 @@ static int stb_text_locate_coord(STB_TEXTEDIT_STRING *str, float x, float y)
       i += r.num_chars;
       base_y += r.baseline_y_delta;
    }
+#endif
 
    // below all text, return 'after' last character
    if (i >= n)
@@ -536,11 +554,20 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
          find->y = 0;
          find->x = 0;
          find->height = 1;
+#ifdef STB_TEXTEDIT_FINDROWBYINDEX
+         // [DEAR IMGUI] the last row is the one containing the last character
+         if (z > 0) {
+            float y;
+            STB_TEXTEDIT_FINDROWBYINDEX(str, z - 1, &prev_start, &first, &y);
+         }
+         i = z;
+#else
          while (i < z) {
             STB_TEXTEDIT_LAYOUTROW(&r, str, i);
             prev_start = i;
             i += r.num_chars;
          }
+#endif
          find->first_char = i;
          find->length = 0;
          find->prev_first = prev_start;
@@ -551,6 +578,11 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
    // search rows to find the one that straddles character n
    find->y = 0;
 
+#ifdef STB_TEXTEDIT_FINDROWBYINDEX
+   // [DEAR IMGUI]
+   STB_TEXTEDIT_FINDROWBYINDEX(str, n, &i, &prev_start, &find->y);
+   STB_TEXTEDIT_LAYOUTROW(&r, str, i);
+#else
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
       if (n < i + r.num_chars)
@@ -559,6 +591,7 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
       i += r.num_chars;
       find->y += r.baseline_y_delta;
    }
+#endif
 
    find->first_char = first = i;
    find->length = r.num_chars;